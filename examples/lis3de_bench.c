@@ -0,0 +1,490 @@
+/**
+  ******************************************************************************
+  * @file    lis3de_bench.c
+  * @author  Sensors Software Solution Team
+  * @brief   Host benchmark of the driver against the lis3de_model.h bus
+  *          model: bus budget per call and sustainable ODR per bus speed
+  *          (README section 2.b), throughput of the stream and
+  *          conversion paths, and the processing chain profiled on a
+  *          recorded bus trace (lis3de_replay_read).
+  *
+  *          cc -O2 -I. examples/lis3de_bench.c lis3de_reg.c -lm \
+  *             -o lis3de_bench
+  *          ./lis3de_bench [cpu_mhz]
+  *
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2021 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under BSD 3-Clause license,
+  * the "License"; You may not use this file except in compliance with the
+  * License. You may obtain a copy of the License at:
+  *                        opensource.org/licenses/BSD-3-Clause
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "lis3de_reg.h"
+#include "lis3de_model.h"
+
+#define BENCH_BLOCKS                 20000U
+#define BENCH_WTM                    16U
+
+static lis3de_model_t model;
+static double cpu_mhz;
+
+/* deterministic test signal: 1 g on Z plus a small vibration */
+static void bench_push(uint32_t n)
+{
+  int8_t v = (int8_t)((n % 16U) < 8U ? 4 : -4);
+
+  lis3de_model_push(&model, v, (int8_t) - v, (int8_t)(64 + v));
+}
+
+static void bench_budget_cell(uint32_t tr, uint32_t bytes)
+{
+  printf(" %3u / %3u B |", (unsigned)tr, (unsigned)bytes);
+}
+
+/* bus use of one call, model counters reset before the call */
+#define BUDGET(call)                                                  \
+  do                                                                  \
+  {                                                                   \
+    model.transactions = 0U;                                          \
+    model.bytes = 0U;                                                 \
+    (void)(call);                                                     \
+    bench_budget_cell(model.transactions, model.bytes);               \
+  } while (0)
+
+static void bench_budget(void)
+{
+  static const char *rows[] =
+  {
+    "lis3de_acceleration_raw_get",
+    "lis3de_sample_get",
+    "lis3de_fifo_mode_set (any RMW setter)",
+    "lis3de_fifo_read_batch, 31 samples",
+    "lis3de_irq_sources_get, IA1 + WTM + click",
+    "ODR, FS, BDU, FIFO enable, WTM, FIFO mode",
+    "same, staged (lis3de_cfg_begin / commit)",
+  };
+  stmdev_ctx_t ctx = { lis3de_model_write, lis3de_model_read, NULL, &model,
+                       NULL
+                     };
+  lis3de_shadow_t shadow;
+  lis3de_priv_t priv[2] = { { .multi_rw = LIS3DE_MULTI_RW_I2C },
+    { .multi_rw = LIS3DE_MULTI_RW_I2C }
+  };
+  lis3de_irq_snapshot_t irq;
+  lis3de_sample_t sample;
+  int16_t xyz[3U * LIS3DE_FIFO_SIZE];
+  uint8_t ctrl[2] = { 0x44U, 0x80U };   /* CTRL_REG3, CTRL_REG6 routing */
+  uint8_t count;
+  uint8_t row;
+  uint8_t cfg;
+  uint32_t i;
+
+  priv[1].shadow = &shadow;
+
+  printf("\nBus budget, transactions / data bytes\n");
+  printf("| %-43s | %-11s | %-11s | %-11s |\n", "Call", "NULL",
+         "multi_rw", "+ shadow");
+
+  for (row = 0U; row < (sizeof(rows) / sizeof(rows[0])); row++)
+  {
+    printf("| %-43s |", rows[row]);
+
+    for (cfg = 0U; cfg < 3U; cfg++)
+    {
+      lis3de_model_init(&model, (uint8_t)LIS3DE_MULTI_RW_I2C);
+      ctx.priv_data = (cfg == 0U) ? NULL : &priv[cfg - 1U];
+
+      if (cfg == 2U)
+      {
+        (void)lis3de_shadow_sync(&ctx);
+      }
+
+      (void)lis3de_write_reg(&ctx, LIS3DE_CTRL_REG3, &ctrl[0], 1);
+      (void)lis3de_write_reg(&ctx, LIS3DE_CTRL_REG6, &ctrl[1], 1);
+
+      switch (row)
+      {
+        case 0:
+          BUDGET(lis3de_acceleration_raw_get(&ctx, xyz));
+          break;
+
+        case 1:
+          BUDGET(lis3de_sample_get(&ctx, &sample));
+          break;
+
+        case 2:
+          BUDGET(lis3de_fifo_mode_set(&ctx, LIS3DE_DYNAMIC_STREAM_MODE));
+          break;
+
+        case 3:
+          for (i = 0U; i < 31U; i++)
+          {
+            bench_push(i);
+          }
+
+          BUDGET(lis3de_fifo_read_batch(&ctx, xyz, LIS3DE_FIFO_SIZE, &count));
+          break;
+
+        case 4:
+          BUDGET(lis3de_irq_sources_get(&ctx, &irq));
+          break;
+
+        case 5:
+          model.transactions = 0U;
+          model.bytes = 0U;
+          (void)lis3de_data_rate_set(&ctx, LIS3DE_ODR_100Hz);
+          (void)lis3de_full_scale_set(&ctx, LIS3DE_4g);
+          (void)lis3de_block_data_update_set(&ctx, PROPERTY_ENABLE);
+          (void)lis3de_fifo_set(&ctx, PROPERTY_ENABLE);
+          (void)lis3de_fifo_watermark_set(&ctx, BENCH_WTM);
+          (void)lis3de_fifo_mode_set(&ctx, LIS3DE_DYNAMIC_STREAM_MODE);
+          bench_budget_cell(model.transactions, model.bytes);
+          break;
+
+        default:
+          if (cfg < 2U)
+          {
+            printf(" %11s |", "-");
+          }
+
+          else
+          {
+            model.transactions = 0U;
+            model.bytes = 0U;
+            (void)lis3de_cfg_begin(&ctx);
+            (void)lis3de_data_rate_set(&ctx, LIS3DE_ODR_100Hz);
+            (void)lis3de_full_scale_set(&ctx, LIS3DE_4g);
+            (void)lis3de_block_data_update_set(&ctx, PROPERTY_ENABLE);
+            (void)lis3de_fifo_set(&ctx, PROPERTY_ENABLE);
+            (void)lis3de_fifo_watermark_set(&ctx, BENCH_WTM);
+            (void)lis3de_fifo_mode_set(&ctx, LIS3DE_DYNAMIC_STREAM_MODE);
+            (void)lis3de_cfg_commit(&ctx);
+            bench_budget_cell(model.transactions, model.bytes);
+          }
+
+          break;
+      }
+    }
+
+    printf("\n");
+  }
+}
+
+/* bus clocks per sample and the ODR they sustain at full bus load */
+static void bench_odr_row(const char *name, uint32_t samples)
+{
+  double i2c = (double)model.i2c_clk / (double)samples;
+  double spi = (double)model.spi_clk / (double)samples;
+
+  printf("| %-40s | %7.1f | %7.0f | %7.0f | %7.1f | %8.0f | %8.0f |\n",
+         name, i2c, 100e3 / i2c, 400e3 / i2c, spi, 1e6 / spi, 10e6 / spi);
+}
+
+static void bench_odr(void)
+{
+  stmdev_ctx_t ctx = { lis3de_model_write, lis3de_model_read, NULL, &model,
+                       NULL
+                     };
+  lis3de_priv_t priv = { .multi_rw = LIS3DE_MULTI_RW_I2C };
+  static int16_t buf[2][3U * LIS3DE_FIFO_SIZE];
+  lis3de_stream_block_t *blk;
+  lis3de_stream_t stream;
+  lis3de_sample_t sample;
+  int16_t xyz[3U * LIS3DE_FIFO_SIZE];
+  uint8_t count;
+  uint8_t cfg;
+  uint32_t i;
+
+  printf("\nSustainable ODR (Hz) at full bus load, bus clocks per sample "
+         "from the model\n");
+  printf("| %-40s | %7s | %7s | %7s | %7s | %8s | %8s |\n", "Path",
+         "I2C clk", "100 kHz", "400 kHz", "SPI clk", "1 MHz", "10 MHz");
+
+  for (cfg = 0U; cfg < 2U; cfg++)
+  {
+    lis3de_model_init(&model, (uint8_t)LIS3DE_MULTI_RW_I2C);
+    ctx.priv_data = (cfg == 0U) ? NULL : &priv;
+    model.i2c_clk = 0U;
+    model.spi_clk = 0U;
+    (void)lis3de_acceleration_raw_get(&ctx, xyz);
+    bench_odr_row((cfg == 0U) ? "lis3de_acceleration_raw_get, NULL" :
+                  "lis3de_acceleration_raw_get, multi_rw", 1U);
+
+    model.i2c_clk = 0U;
+    model.spi_clk = 0U;
+    (void)lis3de_sample_get(&ctx, &sample);
+    bench_odr_row((cfg == 0U) ? "lis3de_sample_get, NULL" :
+                  "lis3de_sample_get, multi_rw", 1U);
+
+    for (i = 0U; i < 31U; i++)
+    {
+      bench_push(i);
+    }
+
+    model.i2c_clk = 0U;
+    model.spi_clk = 0U;
+    (void)lis3de_fifo_read_batch(&ctx, xyz, LIS3DE_FIFO_SIZE, &count);
+    bench_odr_row((cfg == 0U) ? "lis3de_fifo_read_batch 31, NULL" :
+                  "lis3de_fifo_read_batch 31, multi_rw", count);
+  }
+
+  /* watermark stream, interrupt driven: drain only, no polling */
+  lis3de_model_init(&model, (uint8_t)LIS3DE_MULTI_RW_I2C);
+  ctx.priv_data = &priv;
+  (void)lis3de_stream_init(&stream, &ctx, buf[0], buf[1], LIS3DE_FIFO_SIZE);
+  (void)lis3de_stream_start(&stream, BENCH_WTM);
+
+  for (i = 0U; i < BENCH_WTM; i++)
+  {
+    bench_push(i);
+  }
+
+  model.i2c_clk = 0U;
+  model.spi_clk = 0U;
+  (void)lis3de_stream_irq_handler(&stream);
+  blk = lis3de_stream_poll(&stream);
+  count = (blk != NULL) ? blk->count : 0U;
+  (void)lis3de_stream_release_block(&stream, blk);
+  bench_odr_row("lis3de_stream_irq_handler, WTM 16", count);
+}
+
+static void bench_report(const char *name, clock_t ticks, double samples)
+{
+  double s = (double)ticks / (double)CLOCKS_PER_SEC;
+  double ns = (s * 1e9) / samples;
+
+  printf("| %-36s | %12.0f | %9.1f |", name, samples / s, ns);
+
+  if (cpu_mhz > 0.0)
+  {
+    printf(" %10.1f |", (ns * cpu_mhz) / 1000.0);
+  }
+
+  printf("\n");
+}
+
+static void bench_throughput(void)
+{
+  stmdev_ctx_t ctx = { lis3de_model_write, lis3de_model_read, NULL, &model,
+                       NULL
+                     };
+  lis3de_priv_t priv = { .multi_rw = LIS3DE_MULTI_RW_I2C };
+  static int16_t buf[2][3U * LIS3DE_FIFO_SIZE];
+  static float_t mg[3U * LIS3DE_FIFO_SIZE];
+  lis3de_stream_block_t *blk;
+  lis3de_stream_t stream;
+  double samples = (double)BENCH_BLOCKS * BENCH_WTM;
+  clock_t base;
+  clock_t t0;
+  uint32_t b;
+  uint32_t i;
+  uint32_t n = 0U;
+
+  lis3de_model_init(&model, (uint8_t)LIS3DE_MULTI_RW_I2C);
+  ctx.priv_data = &priv;
+  (void)lis3de_stream_init(&stream, &ctx, buf[0], buf[1], LIS3DE_FIFO_SIZE);
+  (void)lis3de_stream_start(&stream, BENCH_WTM);
+
+  /* cost of the model refill alone, subtracted from the paths below */
+  t0 = clock();
+
+  for (b = 0U; b < BENCH_BLOCKS; b++)
+  {
+    for (i = 0U; i < BENCH_WTM; i++)
+    {
+      bench_push(n++);
+    }
+
+    model.lvl = 0U;
+  }
+
+  base = clock() - t0;
+
+  printf("\nThroughput against the model, %u blocks of %u samples\n",
+         (unsigned)BENCH_BLOCKS, (unsigned)BENCH_WTM);
+  printf("| %-36s | %12s | %9s |%s\n", "Path", "samples/s", "ns/sample",
+         (cpu_mhz > 0.0) ? " cyc/sample |" : "");
+
+  t0 = clock();
+
+  for (b = 0U; b < BENCH_BLOCKS; b++)
+  {
+    for (i = 0U; i < BENCH_WTM; i++)
+    {
+      bench_push(n++);
+    }
+
+    (void)lis3de_stream_irq_handler(&stream);
+    blk = lis3de_stream_poll(&stream);
+    (void)lis3de_stream_release_block(&stream, blk);
+  }
+
+  bench_report("stream irq_handler + poll + release", (clock() - t0) - base,
+               samples);
+
+  t0 = clock();
+
+  for (b = 0U; b < BENCH_BLOCKS; b++)
+  {
+    for (i = 0U; i < BENCH_WTM; i++)
+    {
+      bench_push(n++);
+    }
+
+    (void)lis3de_stream_irq_handler(&stream);
+    blk = lis3de_stream_poll(&stream);
+    lis3de_from_fs_to_mg_block(LIS3DE_2g, blk->xyz, mg, blk->count);
+    (void)lis3de_stream_release_block(&stream, blk);
+  }
+
+  bench_report("stream + lis3de_from_fs_to_mg_block", (clock() - t0) - base,
+               samples);
+}
+
+#define BENCH_TRACE_BLOCKS           64U
+#define BENCH_REPEAT                 400U
+
+static void bench_replay(void)
+{
+  stmdev_ctx_t rec = { lis3de_model_write, lis3de_model_read, NULL, &model,
+                       NULL
+                     };
+  stmdev_ctx_t ctx = { lis3de_replay_write, lis3de_replay_read, NULL, NULL,
+                       NULL
+                     };
+  lis3de_priv_t rec_priv = { .multi_rw = LIS3DE_MULTI_RW_I2C };
+  lis3de_priv_t priv = { .multi_rw = LIS3DE_MULTI_RW_I2C };
+  static uint8_t trace_buf[BENCH_TRACE_BLOCKS * 128U];
+  static int16_t xyz[BENCH_TRACE_BLOCKS][3U * BENCH_WTM];
+  static float_t mg[3U * BENCH_WTM];
+  uint8_t count[BENCH_TRACE_BLOCKS];
+  lis3de_feat_engine_t fe;
+  lis3de_feat_t feat[2];
+  lis3de_decim_t dec;
+  lis3de_replay_t rp;
+  lis3de_trace_t trace;
+  lis3de_cal_t cal;
+  double samples = (double)BENCH_TRACE_BLOCKS * BENCH_WTM * BENCH_REPEAT;
+  clock_t t0;
+  uint32_t r;
+  uint32_t b;
+  uint32_t i;
+  uint32_t n = 0U;
+
+  /* record the drains on the model, as on the target */
+  lis3de_model_init(&model, (uint8_t)LIS3DE_MULTI_RW_I2C);
+  (void)lis3de_trace_init(&trace, trace_buf, sizeof(trace_buf));
+  rec_priv.trace = &trace;
+  rec.priv_data = &rec_priv;
+
+  for (b = 0U; b < BENCH_TRACE_BLOCKS; b++)
+  {
+    for (i = 0U; i < BENCH_WTM; i++)
+    {
+      bench_push(n++);
+    }
+
+    (void)lis3de_fifo_read_batch(&rec, xyz[b], BENCH_WTM, &count[b]);
+  }
+
+  (void)lis3de_replay_init(&rp, trace_buf, trace.len);
+  ctx.handle = &rp;
+  ctx.priv_data = &priv;
+
+  lis3de_cal_init(&cal);
+  cal.full = PROPERTY_ENABLE;
+  cal.m[1] = 0.01f;
+  (void)lis3de_decim_init(&dec, NULL, 0U, 4U);
+  (void)lis3de_feat_init(&fe, 256U);
+
+  printf("\nReplay of a %u B trace, %u blocks x %u, %u times\n",
+         (unsigned)trace.len, (unsigned)BENCH_TRACE_BLOCKS,
+         (unsigned)BENCH_WTM, (unsigned)BENCH_REPEAT);
+  printf("| %-36s | %12s | %9s |%s\n", "Stage", "samples/s", "ns/sample",
+         (cpu_mhz > 0.0) ? " cyc/sample |" : "");
+
+  t0 = clock();
+
+  for (r = 0U; r < BENCH_REPEAT; r++)
+  {
+    lis3de_replay_rewind(&rp);
+
+    for (b = 0U; b < BENCH_TRACE_BLOCKS; b++)
+    {
+      (void)lis3de_fifo_read_batch(&ctx, xyz[b], BENCH_WTM, &count[b]);
+    }
+  }
+
+  bench_report("FIFO drain (replay)", clock() - t0, samples);
+
+  t0 = clock();
+
+  for (r = 0U; r < BENCH_REPEAT; r++)
+  {
+    for (b = 0U; b < BENCH_TRACE_BLOCKS; b++)
+    {
+      lis3de_from_fs_to_mg_cal_block(LIS3DE_2g, &cal, xyz[b], mg, count[b]);
+    }
+  }
+
+  bench_report("conversion + calibration (full)", clock() - t0, samples);
+
+  t0 = clock();
+
+  for (r = 0U; r < BENCH_REPEAT; r++)
+  {
+    for (b = 0U; b < BENCH_TRACE_BLOCKS; b++)
+    {
+      (void)lis3de_feat_run(&fe, xyz[b], count[b], feat, 2U);
+    }
+  }
+
+  bench_report("feature extraction", clock() - t0, samples);
+
+  t0 = clock();
+
+  for (r = 0U; r < BENCH_REPEAT; r++)
+  {
+    lis3de_replay_rewind(&rp);
+
+    for (b = 0U; b < BENCH_TRACE_BLOCKS; b++)
+    {
+      (void)lis3de_fifo_read_batch(&ctx, xyz[b], BENCH_WTM, &count[b]);
+      lis3de_from_fs_to_mg_cal_block(LIS3DE_2g, &cal, xyz[b], mg, count[b]);
+      (void)lis3de_feat_run(&fe, xyz[b], count[b], feat, 2U);
+      (void)lis3de_decim_run(&dec, xyz[b], count[b]);
+    }
+  }
+
+  bench_report("drain + cal + features + decimation", clock() - t0, samples);
+
+  if (rp.mismatch != 0U)
+  {
+    printf("replay mismatch: %u\n", (unsigned)rp.mismatch);
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  cpu_mhz = (argc > 1) ? atof(argv[1]) : 0.0;
+
+  bench_budget();
+  bench_odr();
+  bench_throughput();
+  bench_replay();
+
+  return 0;
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,170 @@
+/**
+  ******************************************************************************
+  * @file    lis3de_bench_hpp.cpp
+  * @author  Sensors Software Solution Team
+  * @brief   Host check and benchmark of lis3de_reg.hpp against the
+  *          lis3de_model.h bus model: the Device<Bus, Config> init
+  *          sequence and FIFO drain are compared with the C API (register
+  *          content, samples, bus use) and both drains are timed.
+  *
+  *          cc -O2 -I. -c lis3de_reg.c -o lis3de_reg.o
+  *          c++ -std=c++17 -O2 -I. examples/lis3de_bench_hpp.cpp \
+  *              lis3de_reg.o -o lis3de_bench_hpp
+  *          ./lis3de_bench_hpp
+  *
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2021 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under BSD 3-Clause license,
+  * the "License"; You may not use this file except in compliance with the
+  * License. You may obtain a copy of the License at:
+  *                        opensource.org/licenses/BSD-3-Clause
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include "lis3de_reg.hpp"
+#include "lis3de_model.h"
+
+static lis3de_model_t model;
+
+struct ModelBus
+{
+  static constexpr uint8_t multi_rw = LIS3DE_MULTI_RW_I2C;
+
+  static int32_t read(uint8_t reg, uint8_t *data, uint16_t len)
+  {
+    return lis3de_model_read(&model, reg, data, len);
+  }
+
+  static int32_t write(uint8_t reg, const uint8_t *data, uint16_t len)
+  {
+    return lis3de_model_write(&model, reg, data, len);
+  }
+};
+
+using Cfg = lis3de::Config<LIS3DE_ODR_400Hz, LIS3DE_4g, LIS3DE_NM,
+                           LIS3DE_DYNAMIC_STREAM_MODE, 16U, 0x04U>;
+using Dev = lis3de::Device<ModelBus, Cfg>;
+
+static constexpr uint32_t blocks = 20000U;
+static constexpr uint8_t wtm = 16U;
+
+static void fill(uint32_t &n)
+{
+  for (uint8_t i = 0U; i < wtm; i++, n++)
+  {
+    int8_t v = static_cast<int8_t>(((n % 16U) < 8U) ? 4 : -4);
+    lis3de_model_push(&model, v, static_cast<int8_t>(-v),
+                      static_cast<int8_t>(64 + v));
+  }
+}
+
+static double ns_per_sample(clock_t ticks)
+{
+  return (static_cast<double>(ticks) * 1e9 / CLOCKS_PER_SEC) /
+         (static_cast<double>(blocks) * wtm);
+}
+
+int main()
+{
+  lis3de_priv_t priv = {};
+  stmdev_ctx_t ctx = {};
+  int16_t a[3U * LIS3DE_FIFO_SIZE];
+  int16_t b[3U * LIS3DE_FIFO_SIZE];
+  uint8_t na = 0U;
+  uint8_t nb = 0U;
+  uint32_t tr_cpp;
+  uint32_t tr_c;
+  uint32_t n = 0U;
+  uint32_t i;
+  int fail = 0;
+  clock_t t0;
+  double cpp_ns;
+  double c_ns;
+
+  priv.multi_rw = LIS3DE_MULTI_RW_I2C;
+  ctx = Dev::ctx(&priv);
+
+  /* init: register content and bus use */
+  lis3de_model_init(&model, static_cast<uint8_t>(LIS3DE_MULTI_RW_I2C));
+  (void)Dev::init();
+  tr_cpp = model.transactions;
+
+  for (i = 0U; i < 6U; i++)
+  {
+    if (model.regs[LIS3DE_CTRL_REG1 + i] != Cfg::ctrl[i])
+    {
+      std::printf("CTRL_REG%u: %02X, expected %02X\n",
+                  static_cast<unsigned>(i + 1U),
+                  model.regs[LIS3DE_CTRL_REG1 + i], Cfg::ctrl[i]);
+      fail = 1;
+    }
+  }
+
+  if (model.regs[LIS3DE_FIFO_CTRL_REG] != Cfg::fifo_ctrl)
+  {
+    std::printf("FIFO_CTRL_REG: %02X, expected %02X\n",
+                model.regs[LIS3DE_FIFO_CTRL_REG], Cfg::fifo_ctrl);
+    fail = 1;
+  }
+
+  std::printf("init: %u transactions\n", static_cast<unsigned>(tr_cpp));
+
+  /* same FIFO content through both drains */
+  fill(n);
+  model.transactions = 0U;
+  (void)Dev::fifo_read_batch(a, LIS3DE_FIFO_SIZE, na);
+  tr_cpp = model.transactions;
+  n -= wtm;
+  fill(n);
+  model.transactions = 0U;
+  (void)lis3de_fifo_read_batch(&ctx, b, LIS3DE_FIFO_SIZE, &nb);
+  tr_c = model.transactions;
+
+  if ((na != nb) ||
+      (std::memcmp(a, b, sizeof(int16_t) * 3U * na) != 0) ||
+      (tr_cpp != tr_c))
+  {
+    std::printf("FIFO drain differs from the C API\n");
+    fail = 1;
+  }
+
+  std::printf("drain of %u samples: %u transactions (C API %u)\n",
+              static_cast<unsigned>(na), static_cast<unsigned>(tr_cpp),
+              static_cast<unsigned>(tr_c));
+
+  t0 = std::clock();
+
+  for (i = 0U; i < blocks; i++)
+  {
+    fill(n);
+    (void)Dev::fifo_read_batch(a, LIS3DE_FIFO_SIZE, na);
+  }
+
+  cpp_ns = ns_per_sample(std::clock() - t0);
+  t0 = std::clock();
+
+  for (i = 0U; i < blocks; i++)
+  {
+    fill(n);
+    (void)lis3de_fifo_read_batch(&ctx, b, LIS3DE_FIFO_SIZE, &nb);
+  }
+
+  c_ns = ns_per_sample(std::clock() - t0);
+
+  std::printf("FIFO drain + model refill: Device %.1f ns/sample, "
+              "C API %.1f ns/sample\n", cpp_ns, c_ns);
+  std::printf("%s\n", (fail == 0) ? "PASS" : "FAIL");
+
+  return fail;
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,175 @@
+/**
+  ******************************************************************************
+  * @file    lis3de_model.h
+  * @author  Sensors Software Solution Team
+  * @brief   Host model of the LIS3DE register map and FIFO, usable as the
+  *          read_reg / write_reg of a stmdev_ctx_t (handle = model).
+  *          Used by the benchmark programs of this folder.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2021 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under BSD 3-Clause license,
+  * the "License"; You may not use this file except in compliance with the
+  * License. You may obtain a copy of the License at:
+  *                        opensource.org/licenses/BSD-3-Clause
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef LIS3DE_MODEL_H
+#define LIS3DE_MODEL_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include "lis3de_reg.h"
+
+/**
+  * @brief  Bus clock cycles of one transaction of n data bytes.
+  *         I2C, 9 cycles per byte with its ACK, START / repeated START /
+  *         STOP counted as one cycle each:
+  *         read  S, SAD+W, SUB, Sr, SAD+R, n data, P
+  *         write S, SAD+W, SUB, n data, P
+  *         SPI, 8 cycles per byte, the address byte first, plus
+  *         LIS3DE_MODEL_SPI_CS_CLK for the CS setup and hold.
+  *
+  */
+#define LIS3DE_MODEL_I2C_RD_CLK(n)   ((9U * ((uint32_t)(n) + 3U)) + 3U)
+#define LIS3DE_MODEL_I2C_WR_CLK(n)   ((9U * ((uint32_t)(n) + 2U)) + 2U)
+#define LIS3DE_MODEL_SPI_CS_CLK      2U
+#define LIS3DE_MODEL_SPI_CLK(n)      ((8U * ((uint32_t)(n) + 1U)) + \
+                                      LIS3DE_MODEL_SPI_CS_CLK)
+
+/**
+  * @brief  Register map, 32-level FIFO and bus counters. The FIFO is
+  *         read through OUT_X_L .. OUT_Z_H, the address rolling back
+  *         from 2Dh to 28h and each 2Dh access popping one sample, as on
+  *         the device. bytes excludes the address bytes; i2c_clk and
+  *         spi_clk are the bus clock cycles the same transactions take
+  *         on either bus, the transfer time being clk / f_bus.
+  *
+  */
+typedef struct
+{
+  uint8_t regs[LIS3DE_ADDR_MASK + 1U];
+  int8_t fifo[LIS3DE_FIFO_SIZE][3];
+  uint8_t lvl;
+  uint8_t inc_mask;              /* 80h I2C, 40h SPI */
+  uint32_t transactions;
+  uint32_t bytes;
+  uint32_t i2c_clk;
+  uint32_t spi_clk;
+} lis3de_model_t;
+
+static void lis3de_model_src(lis3de_model_t *m)
+{
+  uint8_t src = m->regs[LIS3DE_FIFO_SRC_REG] & 0x40U;
+
+  src |= (m->lvl == 0U) ? 0x20U : 0x00U;
+  src |= (m->lvl >= (m->regs[LIS3DE_FIFO_CTRL_REG] & 0x1FU)) ? 0x80U : 0x00U;
+  m->regs[LIS3DE_FIFO_SRC_REG] = src | (m->lvl & 0x1FU);
+}
+
+static void lis3de_model_init(lis3de_model_t *m, uint8_t inc_mask)
+{
+  memset(m, 0, sizeof(*m));
+  m->inc_mask = inc_mask;
+  m->regs[LIS3DE_WHO_AM_I] = LIS3DE_ID;
+  m->regs[LIS3DE_CTRL_REG1] = 0x07U;
+  lis3de_model_src(m);
+}
+
+/* stream mode: a full FIFO drops its oldest sample and flags overrun */
+static void lis3de_model_push(lis3de_model_t *m, int8_t x, int8_t y,
+                              int8_t z)
+{
+  if (m->lvl == LIS3DE_FIFO_SIZE)
+  {
+    memmove(m->fifo[0], m->fifo[1], sizeof(m->fifo[0]) * (m->lvl - 1U));
+    m->lvl--;
+    m->regs[LIS3DE_FIFO_SRC_REG] |= 0x40U;
+  }
+
+  m->fifo[m->lvl][0] = x;
+  m->fifo[m->lvl][1] = y;
+  m->fifo[m->lvl][2] = z;
+  m->lvl++;
+  lis3de_model_src(m);
+}
+
+static int32_t lis3de_model_read(void *handle, uint8_t reg, uint8_t *data,
+                                 uint16_t len)
+{
+  lis3de_model_t *m = (lis3de_model_t *)handle;
+  uint8_t addr = reg & LIS3DE_ADDR_MASK;
+  uint8_t inc = ((reg & m->inc_mask) != 0U) ? 1U : 0U;
+  uint16_t i;
+
+  m->transactions++;
+  m->bytes += len;
+  m->i2c_clk += LIS3DE_MODEL_I2C_RD_CLK(len);
+  m->spi_clk += LIS3DE_MODEL_SPI_CLK(len);
+
+  for (i = 0U; i < len; i++)
+  {
+    if ((addr >= LIS3DE_OUT_X_L) && (addr <= LIS3DE_OUT_Z) && (m->lvl > 0U))
+    {
+      m->regs[LIS3DE_OUT_X] = (uint8_t)m->fifo[0][0];
+      m->regs[LIS3DE_OUT_Y] = (uint8_t)m->fifo[0][1];
+      m->regs[LIS3DE_OUT_Z] = (uint8_t)m->fifo[0][2];
+    }
+
+    data[i] = m->regs[addr];
+
+    if ((addr == LIS3DE_OUT_Z) && (m->lvl > 0U))
+    {
+      memmove(m->fifo[0], m->fifo[1], sizeof(m->fifo[0]) * (m->lvl - 1U));
+      m->lvl--;
+      m->regs[LIS3DE_FIFO_SRC_REG] &= 0xBFU;
+      lis3de_model_src(m);
+      addr = LIS3DE_OUT_X_L;
+    }
+
+    else if ((inc == 1U) || (len == 1U))
+    {
+      addr++;
+    }
+
+    else
+    {
+      /* no auto-increment: same register */
+    }
+  }
+
+  return 0;
+}
+
+static int32_t lis3de_model_write(void *handle, uint8_t reg,
+                                  const uint8_t *data, uint16_t len)
+{
+  lis3de_model_t *m = (lis3de_model_t *)handle;
+  uint8_t addr = reg & LIS3DE_ADDR_MASK;
+  uint16_t i;
+
+  m->transactions++;
+  m->bytes += len;
+  m->i2c_clk += LIS3DE_MODEL_I2C_WR_CLK(len);
+  m->spi_clk += LIS3DE_MODEL_SPI_CLK(len);
+
+  for (i = 0U; i < len; i++)
+  {
+    m->regs[addr] = data[i];
+    addr++;
+  }
+
+  lis3de_model_src(m);
+
+  return 0;
+}
+
+#endif /* LIS3DE_MODEL_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
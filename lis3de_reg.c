@@ -37,830 +37,1188 @@
   */
 
 /**
-  * @brief  Read generic device register
+  * @brief  Sub-address flag enabling multi-byte access on the bus in use
   *
   * @param  ctx   read / write interface definitions(ptr)
-  * @param  reg   register to read
-  * @param  data  pointer to buffer that store the data read(ptr)
-  * @param  len   number of consecutive register to read
-  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  * @retval       flag to add to the register address, 0 if multi-byte
+  *               access is not enabled in the context
   *
   */
-int32_t __weak lis3de_read_reg(const stmdev_ctx_t *ctx, uint8_t reg, uint8_t *data,
-                               uint16_t len)
+static uint8_t lis3de_multi_rw(const stmdev_ctx_t *ctx)
 {
-  int32_t ret;
+  const lis3de_priv_t *priv;
+  uint8_t inc = 0U;
 
-  if (ctx == NULL)
+  if ((ctx != NULL) && (ctx->priv_data != NULL))
   {
-    return -1;
+    priv = (const lis3de_priv_t *)ctx->priv_data;
+    inc = (uint8_t)priv->multi_rw;
   }
 
-  ret = ctx->read_reg(ctx->handle, reg, data, len);
-
-  return ret;
+  return inc;
 }
 
 /**
-  * @brief  Write generic device register
+  * @brief  Bus address of a transaction built from the transport of the
+  *         context: SPI read bit, MS / auto-increment bit on bursts.
   *
   * @param  ctx   read / write interface definitions(ptr)
-  * @param  reg   register to write
-  * @param  data  pointer to data to write in register reg(ptr)
-  * @param  len   number of consecutive register to write
-  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  * @param  reg   register, sub-address flags of the caller are dropped
+  * @param  len   number of bytes
+  * @param  read  1 for a read, 0 for a write
+  * @retval       address to pass to the platform, reg unchanged with
+  *               LIS3DE_BUS_RAW
   *
   */
-int32_t __weak lis3de_write_reg(const stmdev_ctx_t *ctx, uint8_t reg,
-                                uint8_t *data,
-                                uint16_t len)
+static uint8_t lis3de_bus_addr(const stmdev_ctx_t *ctx, uint8_t reg,
+                               uint16_t len, uint8_t read)
 {
-  int32_t ret;
+  const lis3de_priv_t *priv;
+  uint8_t addr = reg;
 
-  if (ctx == NULL)
+  if (ctx->priv_data != NULL)
   {
-    return -1;
-  }
+    priv = (const lis3de_priv_t *)ctx->priv_data;
 
-  ret = ctx->write_reg(ctx->handle, reg, data, len);
+    if (priv->bus == LIS3DE_BUS_I2C)
+    {
+      addr = reg & LIS3DE_ADDR_MASK;
+      addr |= (len > 1U) ? (uint8_t)LIS3DE_MULTI_RW_I2C : 0U;
+    }
 
-  return ret;
+    else if (priv->bus != LIS3DE_BUS_RAW)
+    {
+      addr = reg & LIS3DE_ADDR_MASK;
+      addr |= (len > 1U) ? (uint8_t)LIS3DE_MULTI_RW_SPI : 0U;
+      addr |= (read == 1U) ? 0x80U : 0U;
+    }
+
+    else
+    {
+      /* platform builds the address */
+    }
+  }
+
+  return addr;
 }
 
 /**
-  * @}
+  * @brief  Timestamp from the tick source of the context
   *
-  */
-
-/**
-  * @defgroup    LIS3DE_Sensitivity
-  * @brief       These functions convert raw-data into engineering units.
-  * @{
+  * @param  ctx   read / write interface definitions(ptr)
+  * @retval       current tick, 0 if no tick source is set
   *
   */
-
-float_t lis3de_from_fs2_to_mg(int16_t lsb)
-{
-  return ((float_t)lsb) * 15.6f;
-}
-
-float_t lis3de_from_fs4_to_mg(int16_t lsb)
+static uint32_t lis3de_tick(const stmdev_ctx_t *ctx)
 {
-  return ((float_t)lsb) * 31.2f;
-}
+  const lis3de_priv_t *priv;
+  uint32_t tick = 0U;
 
-float_t lis3de_from_fs8_to_mg(int16_t lsb)
-{
-  return ((float_t)lsb) * 62.5f;
-}
+  if ((ctx != NULL) && (ctx->priv_data != NULL))
+  {
+    priv = (const lis3de_priv_t *)ctx->priv_data;
 
-float_t lis3de_from_fs16_to_mg(int16_t lsb)
-{
-  return ((float_t)lsb) * 187.5f;
-}
+    if (priv->tick != NULL)
+    {
+      tick = priv->tick();
+    }
+  }
 
-float_t lis3de_from_lsb_to_celsius(int16_t lsb)
-{
-  return (((float_t)lsb) * 1.0f) + 25.0f;
+  return tick;
 }
 
+#ifdef LIS3DE_BUS_STATS
 /**
-  * @}
+  * @brief  Account a bus transaction in the per register counters
   *
-  */
-
-/**
-  * @defgroup  LIS3DE_Data_generation
-  * @brief     This section group all the functions concerning data generation.
-  * @{
+  * @param  ctx     read / write interface definitions(ptr)
+  * @param  reg     first register of the transaction
+  * @param  len     number of bytes
+  * @param  write   1 for a write, 0 for a read
+  * @param  status  interface status of the transaction
+  * @param  start   tick sampled before the transaction
   *
   */
+static void lis3de_stats_add(const stmdev_ctx_t *ctx, uint8_t reg,
+                             uint16_t len, uint8_t write, int32_t status,
+                             uint32_t start)
+{
+  const lis3de_priv_t *priv = (const lis3de_priv_t *)ctx->priv_data;
+  lis3de_reg_stats_t *stats;
+  uint32_t lat;
+  uint8_t first;
+
+  if ((priv != NULL) && (priv->stats != NULL))
+  {
+    lat = lis3de_tick(ctx) - start;
+    stats = &priv->stats->reg[reg & LIS3DE_ADDR_MASK];
+    /* a zeroed table has no minimum yet */
+    first = ((stats->reads + stats->writes) == 0U) ? 1U : 0U;
+
+    if (write == 1U)
+    {
+      stats->writes++;
+    }
+
+    else
+    {
+      stats->reads++;
+    }
+
+    stats->bytes += len;
+
+    if (status != 0)
+    {
+      stats->errors++;
+    }
+
+    if ((first == 1U) || (lat < stats->lat_min))
+    {
+      stats->lat_min = lat;
+    }
+
+    if (lat > stats->lat_max)
+    {
+      stats->lat_max = lat;
+    }
+
+    stats->lat_sum += lat;
+  }
+}
+#endif /* LIS3DE_BUS_STATS */
 
 /**
-  * @brief  Temperature status register.[get]
+  * @brief  Take the context lock, if any, around a sequence of
+  *         transactions that must not be interleaved with others
   *
-  * @param  ctx      read / write interface definitions
-  * @param  buff     buffer that stores data read
-  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  * @param  ctx   read / write interface definitions(ptr)
   *
   */
-int32_t lis3de_temp_status_reg_get(const stmdev_ctx_t *ctx, uint8_t *buff)
+static void lis3de_lock(const stmdev_ctx_t *ctx)
 {
-  int32_t ret;
+  const lis3de_priv_t *priv;
 
-  ret = lis3de_read_reg(ctx, LIS3DE_STATUS_REG_AUX, buff, 1);
+  if ((ctx != NULL) && (ctx->priv_data != NULL))
+  {
+    priv = (const lis3de_priv_t *)ctx->priv_data;
 
-  return ret;
+    if (priv->lock != NULL)
+    {
+      priv->lock(ctx->handle);
+    }
+  }
 }
+
 /**
-  * @brief  Temperature data available.[get]
+  * @brief  Release the context lock taken by lis3de_lock
   *
-  * @param  ctx      read / write interface definitions
-  * @param  val      change the values of tda in reg STATUS_REG_AUX
-  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  * @param  ctx   read / write interface definitions(ptr)
   *
   */
-int32_t lis3de_temp_data_ready_get(const stmdev_ctx_t *ctx, uint8_t *val)
+static void lis3de_unlock(const stmdev_ctx_t *ctx)
 {
-  lis3de_status_reg_aux_t status_reg_aux;
-  int32_t ret;
+  const lis3de_priv_t *priv;
 
-  ret = lis3de_read_reg(ctx, LIS3DE_STATUS_REG_AUX,
-                        (uint8_t *)&status_reg_aux, 1);
-  *val = status_reg_aux._3da;
+  if ((ctx != NULL) && (ctx->priv_data != NULL))
+  {
+    priv = (const lis3de_priv_t *)ctx->priv_data;
 
-  return ret;
+    if (priv->unlock != NULL)
+    {
+      priv->unlock(ctx->handle);
+    }
+  }
 }
+
 /**
-  * @brief  Temperature data overrun.[get]
+  * @brief  Shadow register cache of the context
   *
-  * @param  ctx      read / write interface definitions
-  * @param  val      change the values of tor in reg STATUS_REG_AUX
-  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  * @param  ctx   read / write interface definitions(ptr)
+  * @retval       shadow cache, NULL if not used
   *
   */
-int32_t lis3de_temp_data_ovr_get(const stmdev_ctx_t *ctx, uint8_t *val)
+static lis3de_shadow_t *lis3de_shadow(const stmdev_ctx_t *ctx)
 {
-  lis3de_status_reg_aux_t status_reg_aux;
-  int32_t ret;
+  const lis3de_priv_t *priv;
+  lis3de_shadow_t *shadow = NULL;
 
-  ret = lis3de_read_reg(ctx, LIS3DE_STATUS_REG_AUX,
-                        (uint8_t *)&status_reg_aux, 1);
-  *val = status_reg_aux._3or;
+  if ((ctx != NULL) && (ctx->priv_data != NULL))
+  {
+    priv = (const lis3de_priv_t *)ctx->priv_data;
+    shadow = priv->shadow;
+  }
 
-  return ret;
+  return shadow;
 }
+
 /**
-  * @brief  Temperature output value.[get]
+  * @brief  Check if a register is held in the shadow cache. Only the
+  *         writable configuration registers are; REFERENCE is excluded
+  *         since reading it resets the high-pass filter.
   *
-  * @param  ctx      read / write interface definitions
-  * @param  buff     buffer that stores data read
-  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  * @param  addr  register address, without sub-address flags
+  * @retval       1 if cached, 0 otherwise
   *
   */
-int32_t lis3de_temperature_raw_get(const stmdev_ctx_t *ctx, uint8_t *buff)
+static uint8_t lis3de_shadow_reg(uint8_t addr)
 {
-  int32_t ret;
+  uint8_t hit = 0U;
 
-  ret = lis3de_read_reg(ctx, LIS3DE_OUT_ADC1_H, buff, 1);
+  if ((addr >= LIS3DE_TEMP_CFG_REG) && (addr <= LIS3DE_ACT_DUR))
+  {
+    switch (addr)
+    {
+      case LIS3DE_REFERENCE:
+      case LIS3DE_STATUS_REG:
+      case LIS3DE_OUT_X_L:
+      case LIS3DE_OUT_X:
+      case 0x2AU:
+      case LIS3DE_OUT_Y:
+      case 0x2CU:
+      case LIS3DE_OUT_Z:
+      case LIS3DE_FIFO_SRC_REG:
+      case LIS3DE_IG1_SOURCE:
+      case LIS3DE_IG2_SOURCE:
+      case LIS3DE_CLICK_SRC:
+        hit = 0U;
+        break;
+
+      default:
+        hit = 1U;
+        break;
+    }
+  }
 
-  return ret;
+  return hit;
 }
 
 /**
-  * @brief  ADC output value.[get]
-  *         Sample frequency: the same as the ODR CTRL_REG1
-  *         The resolution:
-  *                    10bit if LPen bit in CTRL_REG1 (20h) is clear
-  *                     8bit if LPen bit in CTRL_REG1 (20h) is set
-  *         Data Format:
-  *                     Outputs are Left Justified in 2’ complements
-  *                     range 800mV
-  *                     code zero means an analogue value of about 1.2V
-  *                     Voltage values smaller than centre values are positive
-  *                           (Example:  800mV = 7Fh / 127 dec)
-  *                     Voltage values bigger than centre values are negative
-  *                           (Example: 1600mV = 80h / -128 dec)
+  * @brief  Check if a whole register range is held in the shadow cache.
   *
-  * @param  ctx      read / write interface definitions
-  * @param  buff     buffer that stores data read
-  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  * @param  reg   first register, sub-address flags are ignored
+  * @param  len   number of consecutive registers
+  * @retval       1 if all cached, 0 otherwise
   *
   */
-int32_t lis3de_adc_raw_get(const stmdev_ctx_t *ctx, int16_t *val)
+static uint8_t lis3de_shadow_range(uint8_t reg, uint16_t len)
 {
-  uint8_t buff[6];
-  int32_t ret;
+  uint8_t addr = reg & LIS3DE_ADDR_MASK;
+  uint8_t hit = 1U;
+  uint16_t i;
 
-  ret = lis3de_read_reg(ctx, LIS3DE_OUT_ADC1_L, buff, 6);
-  val[0] = (int16_t)buff[1];
-  val[0] = (val[0] * 256) + (int16_t)buff[0];
-  val[1] = (int16_t)buff[3];
-  val[1] = (val[1] * 256) + (int16_t)buff[2];
-  val[2] = (int16_t)buff[5];
-  val[2] = (val[2] * 256) + (int16_t)buff[4];
+  for (i = 0U; (i < len) && (hit == 1U); i++)
+  {
+    hit = lis3de_shadow_reg((uint8_t)(addr + i));
+  }
 
-  return ret;
+  return hit;
 }
 
 /**
-  * @brief  Auxiliary ADC.[set]
+  * @brief  Append a bus transaction to the trace of the context, if any.
+  *         A transaction that does not fit is counted and not recorded.
   *
-  * @param  ctx      read / write interface definitions
-  * @param  val      configure the auxiliary ADC
-  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  * @param  ctx     read / write interface definitions(ptr)
+  * @param  reg     register of the transaction
+  * @param  data    bytes moved on the bus
+  * @param  len     number of bytes
+  * @param  write   1 for a write, 0 for a read
+  * @param  status  interface status of the transaction
   *
   */
-int32_t lis3de_aux_adc_set(const stmdev_ctx_t *ctx, lis3de_temp_en_t val)
+static void lis3de_trace_add(const stmdev_ctx_t *ctx, uint8_t reg,
+                             const uint8_t *data, uint16_t len,
+                             uint8_t write, int32_t status)
 {
-  lis3de_temp_cfg_reg_t temp_cfg_reg;
-  int32_t ret;
-
-  ret = lis3de_read_reg(ctx, LIS3DE_TEMP_CFG_REG,
-                        (uint8_t *)&temp_cfg_reg, 1);
+  const lis3de_priv_t *priv = (const lis3de_priv_t *)ctx->priv_data;
+  lis3de_trace_t *trace;
+  uint16_t num = (status == 0) ? len : 0U;
+  uint32_t need;
+  uint16_t i;
 
-  if (ret == 0)
+  if ((priv != NULL) && (priv->trace != NULL))
   {
-    if (val != LIS3DE_AUX_DISABLE)
+    trace = priv->trace;
+    need = 1U + ((len < 0x80U) ? 1U : 2U) + num;
+
+    if ((trace->size - trace->len) < need)
     {
-      /* Required in order to use auxiliary adc */
-      ret = lis3de_block_data_update_set(ctx, PROPERTY_ENABLE);
+      trace->dropped++;
     }
-  }
 
-  if (ret == 0)
-  {
-    temp_cfg_reg.temp_en = ((uint8_t) val & 0x02U) >> 1;
-    temp_cfg_reg.adc_pd  = (uint8_t) val &  0x01U;
-    ret = lis3de_write_reg(ctx, LIS3DE_TEMP_CFG_REG,
-                           (uint8_t *)&temp_cfg_reg, 1);
+    else
+    {
+      trace->buf[trace->len] = (uint8_t)(reg & LIS3DE_ADDR_MASK);
+      trace->buf[trace->len] |= (write == 1U) ? LIS3DE_TRACE_WRITE : 0U;
+      trace->buf[trace->len] |= (status != 0) ? LIS3DE_TRACE_ERROR : 0U;
+      trace->len++;
+
+      if (len < 0x80U)
+      {
+        trace->buf[trace->len] = (uint8_t)len;
+        trace->len++;
+      }
+
+      else
+      {
+        trace->buf[trace->len] = (uint8_t)((len >> 8) | 0x80U);
+        trace->buf[trace->len + 1U] = (uint8_t)len;
+        trace->len += 2U;
+      }
+
+      for (i = 0U; i < num; i++)
+      {
+        trace->buf[trace->len] = data[i];
+        trace->len++;
+      }
+    }
   }
-
-  return ret;
 }
 
 /**
-  * @brief  Auxiliary ADC.[get]
+  * @brief  Read consecutive registers, in one burst when the context
+  *         has multi-byte access
   *
-  * @param  ctx      read / write interface definitions
-  * @param  val      configure the auxiliary ADC
+  * @param  ctx   read / write interface definitions(ptr)
+  * @param  reg   first register
+  * @param  data  pointer to buffer that store the data read(ptr)
+  * @param  len   number of consecutive register to read
   * @retval          interface status (MANDATORY: return 0 -> no Error)
   *
   */
-int32_t lis3de_aux_adc_get(const stmdev_ctx_t *ctx, lis3de_temp_en_t *val)
+static int32_t lis3de_read_regs(const stmdev_ctx_t *ctx, uint8_t reg,
+                                uint8_t *data, uint8_t len)
 {
-  lis3de_temp_cfg_reg_t temp_cfg_reg;
-  int32_t ret;
-
-  ret = lis3de_read_reg(ctx, LIS3DE_TEMP_CFG_REG,
-                        (uint8_t *)&temp_cfg_reg, 1);
-
-  if ((temp_cfg_reg.temp_en & temp_cfg_reg.adc_pd) ==
-      PROPERTY_ENABLE)
-  {
-    *val = LIS3DE_AUX_ON_TEMPERATURE;
-  }
+  uint8_t inc = lis3de_multi_rw(ctx);
+  uint8_t i;
+  int32_t ret = 0;
 
-  if ((temp_cfg_reg.temp_en  == PROPERTY_DISABLE) &&
-      (temp_cfg_reg.adc_pd == PROPERTY_ENABLE))
+  if ((inc != 0U) && (len > 1U))
   {
-    *val = LIS3DE_AUX_ON_PADS;
+    ret = lis3de_read_reg(ctx, (uint8_t)(reg | inc), data, len);
   }
 
   else
   {
-    *val = LIS3DE_AUX_DISABLE;
+    for (i = 0U; (i < len) && (ret == 0); i++)
+    {
+      ret = lis3de_read_reg(ctx, (uint8_t)(reg + i), &data[i], 1);
+    }
   }
 
   return ret;
 }
 
 /**
-  * @brief  Operating mode selection.[set]
+  * @brief  Write consecutive registers, in one burst when the context
+  *         has multi-byte access
   *
-  * @param  ctx      read / write interface definitions
-  * @param  val      change the values of lpen in reg CTRL_REG1
+  * @param  ctx   read / write interface definitions(ptr)
+  * @param  reg   first register
+  * @param  data  pointer to data to write in the registers(ptr)
+  * @param  len   number of consecutive register to write
   * @retval          interface status (MANDATORY: return 0 -> no Error)
   *
   */
-int32_t lis3de_operating_mode_set(const stmdev_ctx_t *ctx,
-                                  lis3de_op_md_t val)
+static int32_t lis3de_write_regs(const stmdev_ctx_t *ctx, uint8_t reg,
+                                 uint8_t *data, uint8_t len)
 {
-  lis3de_ctrl_reg1_t ctrl_reg1;
-  int32_t ret;
+  uint8_t inc = lis3de_multi_rw(ctx);
+  uint8_t i;
+  int32_t ret = 0;
 
-  ret = lis3de_read_reg(ctx, LIS3DE_CTRL_REG1, (uint8_t *)&ctrl_reg1, 1);
+  if ((inc != 0U) && (len > 1U))
+  {
+    ret = lis3de_write_reg(ctx, (uint8_t)(reg | inc), data, len);
+  }
 
-  if (ret == 0)
+  else
   {
-    ctrl_reg1.lpen = (uint8_t) val;
-    ret = lis3de_write_reg(ctx, LIS3DE_CTRL_REG1, (uint8_t *)&ctrl_reg1, 1);
+    for (i = 0U; (i < len) && (ret == 0); i++)
+    {
+      ret = lis3de_write_reg(ctx, (uint8_t)(reg + i), &data[i], 1);
+    }
   }
 
   return ret;
 }
 
 /**
-  * @brief  Operating mode selection.[get]
+  * @brief  Read generic device register
+  *         Registers held in a valid shadow cache are answered from RAM.
   *
-  * @param  ctx      read / write interface definitions
-  * @param  val      change the values of lpen in reg CTRL_REG1
+  * @param  ctx   read / write interface definitions(ptr)
+  * @param  reg   register to read
+  * @param  data  pointer to buffer that store the data read(ptr)
+  * @param  len   number of consecutive register to read
   * @retval          interface status (MANDATORY: return 0 -> no Error)
   *
   */
-int32_t lis3de_operating_mode_get(const stmdev_ctx_t *ctx,
-                                  lis3de_op_md_t *val)
+int32_t __weak lis3de_read_reg(const stmdev_ctx_t *ctx, uint8_t reg, uint8_t *data,
+                               uint16_t len)
 {
-  lis3de_ctrl_reg1_t ctrl_reg1;
+  lis3de_shadow_t *shadow;
+#ifdef LIS3DE_BUS_STATS
+  uint32_t start;
+#endif /* LIS3DE_BUS_STATS */
+  uint16_t i;
   int32_t ret;
 
-  ret = lis3de_read_reg(ctx, LIS3DE_CTRL_REG1, (uint8_t *)&ctrl_reg1, 1);
+  if (ctx == NULL)
+  {
+    return -1;
+  }
 
-  if (ret == 0)
+  shadow = lis3de_shadow(ctx);
+
+  if ((shadow != NULL) && (shadow->valid == PROPERTY_ENABLE) &&
+      (lis3de_shadow_range(reg, len) == 1U))
   {
-    if (ctrl_reg1.lpen == PROPERTY_ENABLE)
+    for (i = 0U; i < len; i++)
     {
-      *val = LIS3DE_LP;
+      data[i] = shadow->reg[(reg & LIS3DE_ADDR_MASK) + i -
+                            LIS3DE_TEMP_CFG_REG];
     }
 
-    else
-    {
-      *val = LIS3DE_NM;
-    }
+    ret = 0;
   }
 
-  return ret;
-}
-
-/**
-  * @brief  Output data rate selection.[set]
-  *
-  * @param  ctx      read / write interface definitions
-  * @param  val      change the values of odr in reg CTRL_REG1
-  * @retval          interface status (MANDATORY: return 0 -> no Error)
-  *
-  */
-int32_t lis3de_data_rate_set(const stmdev_ctx_t *ctx, lis3de_odr_t val)
-{
-  lis3de_ctrl_reg1_t ctrl_reg1;
-  int32_t ret;
-
-  ret = lis3de_read_reg(ctx, LIS3DE_CTRL_REG1, (uint8_t *)&ctrl_reg1, 1);
-
-  if (ret == 0)
+  else
   {
-    ctrl_reg1.odr = (uint8_t)val;
-    ret = lis3de_write_reg(ctx, LIS3DE_CTRL_REG1, (uint8_t *)&ctrl_reg1, 1);
+#ifdef LIS3DE_BUS_STATS
+    start = lis3de_tick(ctx);
+#endif /* LIS3DE_BUS_STATS */
+    ret = ctx->read_reg(ctx->handle, lis3de_bus_addr(ctx, reg, len, 1U),
+                        data, len);
+#ifdef LIS3DE_BUS_STATS
+    lis3de_stats_add(ctx, reg, len, 0U, ret, start);
+#endif /* LIS3DE_BUS_STATS */
+    lis3de_trace_add(ctx, reg, data, len, 0U, ret);
   }
 
   return ret;
 }
 
 /**
-  * @brief  Output data rate selection.[get]
+  * @brief  Write generic device register
+  *         A valid shadow cache is updated on success and invalidated on
+  *         error. Inside a lis3de_cfg_begin / lis3de_cfg_commit
+  *         transaction, writes to cached registers are only staged.
   *
-  * @param  ctx      read / write interface definitions
-  * @param  val      get the values of odr in reg CTRL_REG1
+  * @param  ctx   read / write interface definitions(ptr)
+  * @param  reg   register to write
+  * @param  data  pointer to data to write in register reg(ptr)
+  * @param  len   number of consecutive register to write
   * @retval          interface status (MANDATORY: return 0 -> no Error)
   *
   */
-int32_t lis3de_data_rate_get(const stmdev_ctx_t *ctx, lis3de_odr_t *val)
+int32_t __weak lis3de_write_reg(const stmdev_ctx_t *ctx, uint8_t reg,
+                                uint8_t *data,
+                                uint16_t len)
 {
-  lis3de_ctrl_reg1_t ctrl_reg1;
-  int32_t ret;
-
-  ret = lis3de_read_reg(ctx, LIS3DE_CTRL_REG1, (uint8_t *)&ctrl_reg1, 1);
+  lis3de_shadow_t *shadow;
+#ifdef LIS3DE_BUS_STATS
+  uint32_t start;
+#endif /* LIS3DE_BUS_STATS */
+  uint8_t staged = 0U;
+  uint8_t addr;
+  uint16_t i;
+  int32_t ret = 0;
 
-  switch (ctrl_reg1.odr)
+  if (ctx == NULL)
   {
-    case LIS3DE_POWER_DOWN:
-      *val = LIS3DE_POWER_DOWN;
-      break;
-
-    case LIS3DE_ODR_1Hz:
-      *val = LIS3DE_ODR_1Hz;
-      break;
-
-    case LIS3DE_ODR_10Hz:
-      *val = LIS3DE_ODR_10Hz;
-      break;
-
-    case LIS3DE_ODR_25Hz:
-      *val = LIS3DE_ODR_25Hz;
-      break;
+    return -1;
+  }
 
-    case LIS3DE_ODR_50Hz:
-      *val = LIS3DE_ODR_50Hz;
-      break;
+  shadow = lis3de_shadow(ctx);
 
-    case LIS3DE_ODR_100Hz:
-      *val = LIS3DE_ODR_100Hz;
-      break;
+  if ((shadow != NULL) && (shadow->valid == PROPERTY_ENABLE) &&
+      (shadow->staging == PROPERTY_ENABLE) &&
+      (lis3de_shadow_range(reg, len) == 1U))
+  {
+    staged = 1U;
+  }
 
-    case LIS3DE_ODR_200Hz:
-      *val = LIS3DE_ODR_200Hz;
-      break;
+  else
+  {
+#ifdef LIS3DE_BUS_STATS
+    start = lis3de_tick(ctx);
+#endif /* LIS3DE_BUS_STATS */
+    ret = ctx->write_reg(ctx->handle, lis3de_bus_addr(ctx, reg, len, 0U),
+                         data, len);
+#ifdef LIS3DE_BUS_STATS
+    lis3de_stats_add(ctx, reg, len, 1U, ret, start);
+#endif /* LIS3DE_BUS_STATS */
+    lis3de_trace_add(ctx, reg, data, len, 1U, ret);
+  }
 
-    case LIS3DE_ODR_400Hz:
-      *val = LIS3DE_ODR_400Hz;
-      break;
+  if ((shadow != NULL) && (shadow->valid == PROPERTY_ENABLE))
+  {
+    if (ret != 0)
+    {
+      shadow->valid = PROPERTY_DISABLE;
+    }
 
-    case LIS3DE_ODR_1kHz6:
-      *val = LIS3DE_ODR_1kHz6;
-      break;
+    for (i = 0U; (i < len) && (ret == 0); i++)
+    {
+      addr = (uint8_t)((reg & LIS3DE_ADDR_MASK) + i);
 
-    case LIS3DE_ODR_5kHz376_LP_1kHz344_NM:
-      *val = LIS3DE_ODR_5kHz376_LP_1kHz344_NM;
-      break;
+      if (lis3de_shadow_reg(addr) == 1U)
+      {
+        shadow->reg[addr - LIS3DE_TEMP_CFG_REG] = data[i];
 
-    default:
-      *val = LIS3DE_POWER_DOWN;
-      break;
+        if (staged == 1U)
+        {
+          shadow->dirty |= (uint64_t)1U << (addr - LIS3DE_TEMP_CFG_REG);
+        }
+      }
+    }
   }
 
   return ret;
 }
 
 /**
-  * @brief   High pass data from internal filter sent to output register
-  *          and FIFO.
+  * @brief  Load the shadow cache from the device. Must be called once
+  *         before the cache is used and again after lis3de_boot_set,
+  *         which invalidates it. Only the cached registers are read.
   *
-  * @param  ctx      read / write interface definitions
-  * @param  val      change the values of fds in reg CTRL_REG2
+  * @param  ctx   read / write interface definitions(ptr)
   * @retval          interface status (MANDATORY: return 0 -> no Error)
   *
   */
-int32_t lis3de_high_pass_on_outputs_set(const stmdev_ctx_t *ctx,
-                                        uint8_t val)
+int32_t lis3de_shadow_sync(const stmdev_ctx_t *ctx)
 {
-  lis3de_ctrl_reg2_t ctrl_reg2;
-  int32_t ret;
+  lis3de_shadow_t *shadow = lis3de_shadow(ctx);
+  uint8_t inc = lis3de_multi_rw(ctx);
+  uint8_t first;
+  uint8_t last;
+  uint8_t addr;
+  int32_t ret = 0;
+
+  if (shadow == NULL)
+  {
+    return -1;
+  }
 
-  ret = lis3de_read_reg(ctx, LIS3DE_CTRL_REG2, (uint8_t *)&ctrl_reg2, 1);
+  lis3de_lock(ctx);
+
+  shadow->valid = PROPERTY_DISABLE;
+  shadow->staging = PROPERTY_DISABLE;
+  shadow->dirty = 0U;
+  first = LIS3DE_TEMP_CFG_REG;
+
+  /* one transaction per run of cached registers with multi-byte access */
+  while ((first <= LIS3DE_ACT_DUR) && (ret == 0))
+  {
+    if (lis3de_shadow_reg(first) == 0U)
+    {
+      first++;
+    }
+
+    else
+    {
+      last = first;
+
+      while ((inc != 0U) && (last < LIS3DE_ACT_DUR) &&
+             (lis3de_shadow_reg(last + 1U) == 1U))
+      {
+        last++;
+      }
+
+      addr = (first == last) ? first : (uint8_t)(first | inc);
+      ret = lis3de_read_reg(ctx, addr,
+                            &shadow->reg[first - LIS3DE_TEMP_CFG_REG],
+                            (uint16_t)last - first + 1U);
+      first = last + 1U;
+    }
+  }
 
   if (ret == 0)
   {
-    ctrl_reg2.fds = val;
-    ret = lis3de_write_reg(ctx, LIS3DE_CTRL_REG2, (uint8_t *)&ctrl_reg2, 1);
+    shadow->valid = PROPERTY_ENABLE;
   }
 
+  lis3de_unlock(ctx);
+
   return ret;
 }
 
 /**
-  * @brief   High pass data from internal filter sent to output register
-  *          and FIFO.[get]
+  * @brief  Open a configuration transaction: the following setters only
+  *         update the shadow cache, nothing is sent to the device until
+  *         lis3de_cfg_commit. Needs a valid shadow cache.
+  *         Writes to registers that are not cached (e.g. REFERENCE) are
+  *         still sent immediately.
   *
-  * @param  ctx      read / write interface definitions
-  * @param  val      change the values of fds in reg CTRL_REG2
-  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  * @param  ctx   read / write interface definitions(ptr)
+  * @retval       0 -> no Error, -1 -> no valid shadow cache
   *
   */
-int32_t lis3de_high_pass_on_outputs_get(const stmdev_ctx_t *ctx,
-                                        uint8_t *val)
+int32_t lis3de_cfg_begin(const stmdev_ctx_t *ctx)
 {
-  lis3de_ctrl_reg2_t ctrl_reg2;
-  int32_t ret;
+  lis3de_shadow_t *shadow = lis3de_shadow(ctx);
+  int32_t ret = -1;
 
-  ret = lis3de_read_reg(ctx, LIS3DE_CTRL_REG2, (uint8_t *)&ctrl_reg2, 1);
-  *val = (uint8_t)ctrl_reg2.fds;
+  if ((shadow != NULL) && (shadow->valid == PROPERTY_ENABLE))
+  {
+    shadow->staging = PROPERTY_ENABLE;
+    shadow->dirty = 0U;
+    ret = 0;
+  }
 
   return ret;
 }
 
 /**
-  * @brief   High-pass filter cutoff frequency selection.[set]
+  * @brief  Apply the staged configuration. Runs of consecutive cached
+  *         registers are written in one burst with multi-byte access;
+  *         clean registers between two dirty ones are rewritten to keep
+  *         the run unbroken (CTRL_REG1..CTRL_REG6 in a single transfer).
   *
-  * HPCF[2:1]\ft @1Hz    @10Hz  @25Hz  @50Hz @100Hz @200Hz @400Hz @1kHz6 ft@5kHz
-  * AGGRESSIVE   0.02Hz  0.2Hz  0.5Hz  1Hz   2Hz    4Hz    8Hz    32Hz   100Hz
-  * STRONG       0.008Hz 0.08Hz 0.2Hz  0.5Hz 1Hz    2Hz    4Hz    16Hz   50Hz
-  * MEDIUM       0.004Hz 0.04Hz 0.1Hz  0.2Hz 0.5Hz  1Hz    2Hz    8Hz    25Hz
-  * LIGHT        0.002Hz 0.02Hz 0.05Hz 0.1Hz 0.2Hz  0.5Hz  1Hz    4Hz    12Hz
-  *
-  * @param  ctx      read / write interface definitions
-  * @param  val      change the values of hpcf in reg CTRL_REG2
+  * @param  ctx   read / write interface definitions(ptr)
   * @retval          interface status (MANDATORY: return 0 -> no Error)
   *
   */
-int32_t lis3de_high_pass_bandwidth_set(const stmdev_ctx_t *ctx,
-                                       lis3de_hpcf_t val)
+int32_t lis3de_cfg_commit(const stmdev_ctx_t *ctx)
 {
-  lis3de_ctrl_reg2_t ctrl_reg2;
-  int32_t ret;
+  lis3de_shadow_t *shadow = lis3de_shadow(ctx);
+  uint8_t inc = lis3de_multi_rw(ctx);
+  uint64_t dirty;
+  uint8_t first;
+  uint8_t last;
+  uint8_t next;
+  uint8_t addr;
+  int32_t ret = 0;
+
+  if ((shadow == NULL) || (shadow->staging == PROPERTY_DISABLE))
+  {
+    return -1;
+  }
 
-  ret = lis3de_read_reg(ctx, LIS3DE_CTRL_REG2, (uint8_t *)&ctrl_reg2, 1);
+  lis3de_lock(ctx);
 
-  if (ret == 0)
+  dirty = shadow->dirty;
+  shadow->staging = PROPERTY_DISABLE;
+  shadow->dirty = 0U;
+  first = 0U;
+
+  while ((first < LIS3DE_SHADOW_SIZE) && (ret == 0))
   {
-    ctrl_reg2.hpcf = (uint8_t)val;
-    ret = lis3de_write_reg(ctx, LIS3DE_CTRL_REG2, (uint8_t *)&ctrl_reg2, 1);
+    if ((dirty & ((uint64_t)1U << first)) == 0U)
+    {
+      first++;
+    }
+
+    else
+    {
+      last = first;
+      next = first + 1U;
+
+      /* extend up to the last dirty register reachable through cached ones */
+      while ((inc != 0U) && (next < LIS3DE_SHADOW_SIZE) &&
+             (lis3de_shadow_reg((uint8_t)(next + LIS3DE_TEMP_CFG_REG)) == 1U))
+      {
+        if ((dirty & ((uint64_t)1U << next)) != 0U)
+        {
+          last = next;
+        }
+
+        next++;
+      }
+
+      addr = first + LIS3DE_TEMP_CFG_REG;
+      addr = (first == last) ? addr : (uint8_t)(addr | inc);
+      ret = lis3de_write_reg(ctx, addr, &shadow->reg[first],
+                             (uint16_t)last - first + 1U);
+      first = last + 1U;
+    }
   }
 
+  lis3de_unlock(ctx);
+
   return ret;
 }
 
 /**
-  * @brief   High-pass filter cutoff frequency selection.[get]
-  *
-  * HPCF[2:1]\ft @1Hz    @10Hz  @25Hz  @50Hz @100Hz @200Hz @400Hz @1kHz6 ft@5kHz
-  * AGGRESSIVE   0.02Hz  0.2Hz  0.5Hz  1Hz   2Hz    4Hz    8Hz    32Hz   100Hz
-  * STRONG       0.008Hz 0.08Hz 0.2Hz  0.5Hz 1Hz    2Hz    4Hz    16Hz   50Hz
-  * MEDIUM       0.004Hz 0.04Hz 0.1Hz  0.2Hz 0.5Hz  1Hz    2Hz    8Hz    25Hz
-  * LIGHT        0.002Hz 0.02Hz 0.05Hz 0.1Hz 0.2Hz  0.5Hz  1Hz    4Hz    12Hz
+  * @brief  Drop the staged configuration and reload the shadow cache
+  *         from the device.
   *
-  * @param  ctx      read / write interface definitions
-  * @param  val      get the values of hpcf in reg CTRL_REG2
+  * @param  ctx   read / write interface definitions(ptr)
   * @retval          interface status (MANDATORY: return 0 -> no Error)
   *
   */
-int32_t lis3de_high_pass_bandwidth_get(const stmdev_ctx_t *ctx,
-                                       lis3de_hpcf_t *val)
+int32_t lis3de_cfg_abort(const stmdev_ctx_t *ctx)
 {
-  lis3de_ctrl_reg2_t ctrl_reg2;
   int32_t ret;
 
-  ret = lis3de_read_reg(ctx, LIS3DE_CTRL_REG2, (uint8_t *)&ctrl_reg2, 1);
+  ret = lis3de_shadow_sync(ctx);
 
-  switch (ctrl_reg2.hpcf)
-  {
-    case LIS3DE_AGGRESSIVE:
-      *val = LIS3DE_AGGRESSIVE;
-      break;
+  return ret;
+}
 
-    case LIS3DE_STRONG:
-      *val = LIS3DE_STRONG;
-      break;
+#ifdef LIS3DE_BUS_STATS
+/**
+  * @brief  Bus counters of a register, transactions being accounted on
+  *         their first register. Average latency is
+  *         lat_sum / (reads + writes).[get]
+  *
+  * @param  ctx   read / write interface definitions(ptr)
+  * @param  reg   register address
+  * @param  val   copy of the counters
+  * @retval       0 -> no Error, -1 -> no counters in the context
+  *
+  */
+int32_t lis3de_stats_get(const stmdev_ctx_t *ctx, uint8_t reg,
+                         lis3de_reg_stats_t *val)
+{
+  const lis3de_priv_t *priv = NULL;
+  int32_t ret = 0;
 
-    case LIS3DE_MEDIUM:
-      *val = LIS3DE_MEDIUM;
-      break;
+  if (ctx != NULL)
+  {
+    priv = (const lis3de_priv_t *)ctx->priv_data;
+  }
 
-    case LIS3DE_LIGHT:
-      *val = LIS3DE_LIGHT;
-      break;
+  if ((priv == NULL) || (priv->stats == NULL))
+  {
+    ret = -1;
+  }
 
-    default:
-      *val = LIS3DE_LIGHT;
-      break;
+  else
+  {
+    *val = priv->stats->reg[reg & LIS3DE_ADDR_MASK];
   }
 
   return ret;
 }
 
 /**
-  * @brief  High-pass filter mode selection.[set]
+  * @brief  Clear the bus counters of all the registers.
   *
-  * @param  ctx      read / write interface definitions
-  * @param  val      change the values of hpm in reg CTRL_REG2
-  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  * @param  ctx   read / write interface definitions(ptr)
+  * @retval       0 -> no Error, -1 -> no counters in the context
   *
   */
-int32_t lis3de_high_pass_mode_set(const stmdev_ctx_t *ctx, lis3de_hpm_t val)
+int32_t lis3de_stats_reset(const stmdev_ctx_t *ctx)
 {
-  lis3de_ctrl_reg2_t ctrl_reg2;
-  int32_t ret;
+  const lis3de_priv_t *priv = NULL;
+  lis3de_reg_stats_t *stats;
+  uint8_t i;
+  int32_t ret = 0;
 
-  ret = lis3de_read_reg(ctx, LIS3DE_CTRL_REG2, (uint8_t *)&ctrl_reg2, 1);
+  if (ctx != NULL)
+  {
+    priv = (const lis3de_priv_t *)ctx->priv_data;
+  }
 
-  if (ret == 0)
+  if ((priv == NULL) || (priv->stats == NULL))
   {
-    ctrl_reg2.hpm = (uint8_t)val;
-    ret = lis3de_write_reg(ctx, LIS3DE_CTRL_REG2, (uint8_t *)&ctrl_reg2, 1);
+    ret = -1;
+  }
+
+  else
+  {
+    for (i = 0U; i <= LIS3DE_ADDR_MASK; i++)
+    {
+      stats = &priv->stats->reg[i];
+      stats->reads = 0U;
+      stats->writes = 0U;
+      stats->bytes = 0U;
+      stats->errors = 0U;
+      stats->lat_min = 0xFFFFFFFFU;
+      stats->lat_max = 0U;
+      stats->lat_sum = 0U;
+    }
   }
 
   return ret;
 }
+#endif /* LIS3DE_BUS_STATS */
 
 /**
-  * @brief  High-pass filter mode selection.[get]
-  *
-  * @param  ctx      read / write interface definitions
-  * @param  val      get the values of hpm in reg CTRL_REG2
-  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  * @}
   *
   */
-int32_t lis3de_high_pass_mode_get(const stmdev_ctx_t *ctx,
-                                  lis3de_hpm_t *val)
-{
-  lis3de_ctrl_reg2_t ctrl_reg2;
-  int32_t ret;
 
-  ret = lis3de_read_reg(ctx, LIS3DE_CTRL_REG2, (uint8_t *)&ctrl_reg2, 1);
+/**
+  * @defgroup    LIS3DE_Sensitivity
+  * @brief       These functions convert raw-data into engineering units.
+  * @{
+  *
+  */
 
-  switch (ctrl_reg2.hpm)
-  {
-    case LIS3DE_NORMAL_WITH_RST:
-      *val = LIS3DE_NORMAL_WITH_RST;
-      break;
+float_t lis3de_from_fs2_to_mg(int16_t lsb)
+{
+  return ((float_t)lsb) * 15.6f;
+}
 
-    case LIS3DE_REFERENCE_MODE:
-      *val = LIS3DE_REFERENCE_MODE;
+float_t lis3de_from_fs4_to_mg(int16_t lsb)
+{
+  return ((float_t)lsb) * 31.2f;
+}
+
+float_t lis3de_from_fs8_to_mg(int16_t lsb)
+{
+  return ((float_t)lsb) * 62.5f;
+}
+
+float_t lis3de_from_fs16_to_mg(int16_t lsb)
+{
+  return ((float_t)lsb) * 187.5f;
+}
+
+float_t lis3de_from_lsb_to_celsius(int16_t lsb)
+{
+  return (((float_t)lsb) * 1.0f) + 25.0f;
+}
+
+/**
+  * @brief  Sensitivity of a full scale, mg/LSB
+  *
+  * @param  fs       full scale
+  * @retval          sensitivity
+  *
+  */
+static float_t lis3de_fs_sensitivity(lis3de_fs_t fs)
+{
+  float_t sens;
+
+  switch (fs)
+  {
+    case LIS3DE_4g:
+      sens = 31.2f;
       break;
 
-    case LIS3DE_NORMAL:
-      *val = LIS3DE_NORMAL;
+    case LIS3DE_8g:
+      sens = 62.5f;
       break;
 
-    case LIS3DE_AUTORST_ON_INT:
-      *val = LIS3DE_AUTORST_ON_INT;
+    case LIS3DE_16g:
+      sens = 187.5f;
       break;
 
+    case LIS3DE_2g:
     default:
-      *val = LIS3DE_NORMAL_WITH_RST;
+      sens = 15.6f;
       break;
   }
 
-  return ret;
+  return sens;
 }
 
 /**
-  * @brief  Full-scale configuration.[set]
+  * @brief  Convert a block of raw samples into mg. The sensitivity is
+  *         selected once for the whole block; the loop body is a plain
+  *         multiply the compiler can vectorize.
   *
-  * @param  ctx      read / write interface definitions
-  * @param  val      change the values of fs in reg CTRL_REG4
-  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  * @param  fs       full scale the samples were acquired with
+  * @param  in       raw samples (e.g. interleaved X, Y, Z)
+  * @param  out      converted samples, may not overlap in
+  * @param  n        number of items (3 per XYZ sample)
   *
   */
-int32_t lis3de_full_scale_set(const stmdev_ctx_t *ctx, lis3de_fs_t val)
+void lis3de_from_fs_to_mg_block(lis3de_fs_t fs, const int16_t *in,
+                                float_t *out, size_t n)
 {
-  lis3de_ctrl_reg4_t ctrl_reg4;
-  int32_t ret;
-
-  ret = lis3de_read_reg(ctx, LIS3DE_CTRL_REG4, (uint8_t *)&ctrl_reg4, 1);
+  float_t sens = lis3de_fs_sensitivity(fs);
+  size_t i;
 
-  if (ret == 0)
+  for (i = 0U; i < n; i++)
   {
-    ctrl_reg4.fs = (uint8_t)val;
-    ret = lis3de_write_reg(ctx, LIS3DE_CTRL_REG4, (uint8_t *)&ctrl_reg4, 1);
+    out[i] = ((float_t)in[i]) * sens;
   }
-
-  return ret;
 }
 
 /**
-  * @brief  Full-scale configuration.[get]
+  * @brief  Integer sensitivity for a full scale.
   *
-  * @param  ctx      read / write interface definitions
-  * @param  val      get the values of fs in reg CTRL_REG4
-  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  * @param  fs       full scale
+  * @param  q16      0 -> micro-g per LSB, 1 -> mg per LSB in Q16.16
+  * @retval          multiplier
   *
   */
-int32_t lis3de_full_scale_get(const stmdev_ctx_t *ctx, lis3de_fs_t *val)
+static int32_t lis3de_fs_multiplier(lis3de_fs_t fs, uint8_t q16)
 {
-  lis3de_ctrl_reg4_t ctrl_reg4;
-  int32_t ret;
+  int32_t mul;
 
-  ret = lis3de_read_reg(ctx, LIS3DE_CTRL_REG4, (uint8_t *)&ctrl_reg4, 1);
-
-  switch (ctrl_reg4.fs)
+  switch (fs)
   {
-    case LIS3DE_2g:
-      *val = LIS3DE_2g;
-      break;
-
     case LIS3DE_4g:
-      *val = LIS3DE_4g;
+      mul = (q16 == 1U) ? LIS3DE_FS4_Q16_PER_LSB : LIS3DE_FS4_UG_PER_LSB;
       break;
 
     case LIS3DE_8g:
-      *val = LIS3DE_8g;
+      mul = (q16 == 1U) ? LIS3DE_FS8_Q16_PER_LSB : LIS3DE_FS8_UG_PER_LSB;
       break;
 
     case LIS3DE_16g:
-      *val = LIS3DE_16g;
+      mul = (q16 == 1U) ? LIS3DE_FS16_Q16_PER_LSB : LIS3DE_FS16_UG_PER_LSB;
       break;
 
+    case LIS3DE_2g:
     default:
-      *val = LIS3DE_2g;
+      mul = (q16 == 1U) ? LIS3DE_FS2_Q16_PER_LSB : LIS3DE_FS2_UG_PER_LSB;
       break;
   }
 
-  return ret;
+  return mul;
 }
 
 /**
-  * @brief  Block Data Update.[set]
+  * @brief  Convert a raw sample into micro-g, integer only.
+  *         Exact for the 8-bit output range; lis3de_from_fsX_to_mg
+  *         differs by less than 0.002 mg because of float rounding.
   *
-  * @param  ctx      read / write interface definitions
-  * @param  val      change the values of bdu in reg CTRL_REG4
-  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  * @param  fs       full scale the sample was acquired with
+  * @param  lsb      raw sample (-128 .. 127)
+  * @retval          acceleration in micro-g
   *
   */
-int32_t lis3de_block_data_update_set(const stmdev_ctx_t *ctx, uint8_t val)
+int32_t lis3de_from_fs_to_ug(lis3de_fs_t fs, int16_t lsb)
 {
-  lis3de_ctrl_reg4_t ctrl_reg4;
-  int32_t ret;
-
-  ret = lis3de_read_reg(ctx, LIS3DE_CTRL_REG4, (uint8_t *)&ctrl_reg4, 1);
-
-  if (ret == 0)
-  {
-    ctrl_reg4.bdu = val;
-    ret = lis3de_write_reg(ctx, LIS3DE_CTRL_REG4, (uint8_t *)&ctrl_reg4, 1);
-  }
-
-  return ret;
+  return (int32_t)lsb * lis3de_fs_multiplier(fs, 0U);
 }
 
 /**
-  * @brief  Block Data Update.[get]
+  * @brief  Convert a raw sample into mg in Q16.16, integer only.
+  *         Multipliers are rounded to the nearest 1/65536 mg: the error
+  *         against the exact value is below 0.001 mg for the 8-bit
+  *         output range (exact at 8g and 16g).
   *
-  * @param  ctx      read / write interface definitions
-  * @param  val      change the values of bdu in reg CTRL_REG4
-  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  * @param  fs       full scale the sample was acquired with
+  * @param  lsb      raw sample (-128 .. 127)
+  * @retval          acceleration in mg, Q16.16
   *
   */
-int32_t lis3de_block_data_update_get(const stmdev_ctx_t *ctx, uint8_t *val)
+int32_t lis3de_from_fs_to_mg_q16(lis3de_fs_t fs, int16_t lsb)
 {
-  lis3de_ctrl_reg4_t ctrl_reg4;
-  int32_t ret;
+  return (int32_t)lsb * lis3de_fs_multiplier(fs, 1U);
+}
 
-  ret = lis3de_read_reg(ctx, LIS3DE_CTRL_REG4, (uint8_t *)&ctrl_reg4, 1);
-  *val = (uint8_t)ctrl_reg4.bdu;
+/**
+  * @brief  Convert a block of raw samples into micro-g, integer only.
+  *
+  * @param  fs       full scale the samples were acquired with
+  * @param  in       raw samples (-128 .. 127)
+  * @param  out      converted samples
+  * @param  n        number of items (3 per XYZ sample)
+  *
+  */
+void lis3de_from_fs_to_ug_block(lis3de_fs_t fs, const int16_t *in,
+                                int32_t *out, size_t n)
+{
+  int32_t mul = lis3de_fs_multiplier(fs, 0U);
+  size_t i;
 
-  return ret;
+  for (i = 0U; i < n; i++)
+  {
+    out[i] = (int32_t)in[i] * mul;
+  }
 }
 
 /**
-  * @brief  Reference value for interrupt generation.[set]
-  *         LSB = ~16@2g / ~31@4g / ~63@8g / ~127@16g
+  * @brief  Convert a block of raw samples into mg in Q16.16, integer only.
   *
-  * @param  ctx      read / write interface definitions
-  * @param  buff     buffer that contains data to write
-  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  * @param  fs       full scale the samples were acquired with
+  * @param  in       raw samples (-128 .. 127)
+  * @param  out      converted samples
+  * @param  n        number of items (3 per XYZ sample)
   *
   */
-int32_t lis3de_filter_reference_set(const stmdev_ctx_t *ctx, uint8_t *buff)
+void lis3de_from_fs_to_mg_q16_block(lis3de_fs_t fs, const int16_t *in,
+                                    int32_t *out, size_t n)
 {
-  int32_t ret;
-
-  ret = lis3de_write_reg(ctx, LIS3DE_REFERENCE, buff, 1);
+  int32_t mul = lis3de_fs_multiplier(fs, 1U);
+  size_t i;
 
-  return ret;
+  for (i = 0U; i < n; i++)
+  {
+    out[i] = (int32_t)in[i] * mul;
+  }
 }
 
 /**
-  * @brief  Reference value for interrupt generation.[get]
-  *         LSB = ~16@2g / ~31@4g / ~63@8g / ~127@16g
+  * @brief  Set a float calibration to identity (no offset, unit gain).
   *
-  * @param  ctx      read / write interface definitions
-  * @param  buff     buffer that stores data read
-  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  * @param  cal      calibration object
   *
   */
-int32_t lis3de_filter_reference_get(const stmdev_ctx_t *ctx, uint8_t *buff)
+void lis3de_cal_init(lis3de_cal_t *cal)
 {
-  int32_t ret;
+  uint8_t i;
 
-  ret = lis3de_read_reg(ctx, LIS3DE_REFERENCE, buff, 1);
+  for (i = 0U; i < 9U; i++)
+  {
+    cal->m[i] = ((i % 4U) == 0U) ? 1.0f : 0.0f;
+  }
 
-  return ret;
+  cal->offset[0] = 0.0f;
+  cal->offset[1] = 0.0f;
+  cal->offset[2] = 0.0f;
+  cal->full = PROPERTY_DISABLE;
 }
+
 /**
-  * @brief  Acceleration set of data available.[get]
+  * @brief  Set a fixed-point calibration to identity.
   *
-  * @param  ctx      read / write interface definitions
-  * @param  val      change the values of zyxda in reg STATUS_REG
-  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  * @param  cal      calibration object
   *
   */
-int32_t lis3de_xl_data_ready_get(const stmdev_ctx_t *ctx, uint8_t *val)
+void lis3de_cal_q_init(lis3de_cal_q_t *cal)
 {
-  lis3de_status_reg_t status_reg;
-  int32_t ret;
+  uint8_t i;
 
-  ret = lis3de_read_reg(ctx, LIS3DE_STATUS_REG, (uint8_t *)&status_reg, 1);
-  *val = status_reg.zyxda;
+  for (i = 0U; i < 9U; i++)
+  {
+    cal->m_q14[i] = ((i % 4U) == 0U) ? 16384 : 0;
+  }
 
-  return ret;
+  cal->offset_ug[0] = 0;
+  cal->offset_ug[1] = 0;
+  cal->offset_ug[2] = 0;
+  cal->full = PROPERTY_DISABLE;
 }
+
 /**
-  * @brief  Acceleration set of data overrun.[get]
-  *
-  * @param  ctx      read / write interface definitions
-  * @param  val      change the values of zyxor in reg STATUS_REG
-  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  * @brief  Convert a block of interleaved (X, Y, Z) raw samples into
+  *         calibrated mg: out = M * (raw * sensitivity - offset).
+  *         Sensitivity and offset are folded into M once per block, so
+  *         each item costs one multiply-add per matrix term (one term
+  *         when only the diagonal is used).
+  *
+  * @param  fs       full scale the samples were acquired with
+  * @param  cal      calibration, offset in mg
+  * @param  in       raw samples
+  * @param  out      calibrated samples, may not overlap in
+  * @param  num      number of XYZ samples
   *
   */
-int32_t lis3de_xl_data_ovr_get(const stmdev_ctx_t *ctx, uint8_t *val)
+void lis3de_from_fs_to_mg_cal_block(lis3de_fs_t fs, const lis3de_cal_t *cal,
+                                    const int16_t *in, float_t *out,
+                                    size_t num)
 {
-  lis3de_status_reg_t status_reg;
-  int32_t ret;
+  float_t sens = lis3de_fs_sensitivity(fs);
+  float_t k[9];
+  float_t b[3];
+  const int16_t *raw;
+  size_t i;
+  uint8_t r;
+
+  for (r = 0U; r < 3U; r++)
+  {
+    k[r * 3U] = cal->m[r * 3U] * sens;
+    k[(r * 3U) + 1U] = cal->m[(r * 3U) + 1U] * sens;
+    k[(r * 3U) + 2U] = cal->m[(r * 3U) + 2U] * sens;
 
-  ret = lis3de_read_reg(ctx, LIS3DE_STATUS_REG, (uint8_t *)&status_reg, 1);
-  *val = status_reg.zyxor;
+    if (cal->full == PROPERTY_ENABLE)
+    {
+      b[r] = (cal->m[r * 3U] * cal->offset[0]) +
+             (cal->m[(r * 3U) + 1U] * cal->offset[1]) +
+             (cal->m[(r * 3U) + 2U] * cal->offset[2]);
+    }
 
-  return ret;
+    else
+    {
+      b[r] = cal->m[r * 4U] * cal->offset[r];
+    }
+  }
+
+  for (i = 0U; i < num; i++)
+  {
+    raw = &in[i * 3U];
+
+    if (cal->full == PROPERTY_ENABLE)
+    {
+      out[i * 3U] = (k[0] * (float_t)raw[0]) + (k[1] * (float_t)raw[1]) +
+                    (k[2] * (float_t)raw[2]) - b[0];
+      out[(i * 3U) + 1U] = (k[3] * (float_t)raw[0]) +
+                           (k[4] * (float_t)raw[1]) +
+                           (k[5] * (float_t)raw[2]) - b[1];
+      out[(i * 3U) + 2U] = (k[6] * (float_t)raw[0]) +
+                           (k[7] * (float_t)raw[1]) +
+                           (k[8] * (float_t)raw[2]) - b[2];
+    }
+
+    else
+    {
+      out[i * 3U] = (k[0] * (float_t)raw[0]) - b[0];
+      out[(i * 3U) + 1U] = (k[4] * (float_t)raw[1]) - b[1];
+      out[(i * 3U) + 2U] = (k[8] * (float_t)raw[2]) - b[2];
+    }
+  }
 }
+
 /**
-  * @brief  Acceleration output value.[get]
+  * @brief  Convert a block of interleaved (X, Y, Z) raw samples into
+  *         calibrated micro-g, integer only. M is Q14 (-2.0 .. 2.0),
+  *         folded with the sensitivity once per block; the per-item
+  *         accumulation fits int32 for the 8-bit output range.
   *
-  * @param  ctx      read / write interface definitions
-  * @param  buff     buffer that stores data read
-  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  * @param  fs       full scale the samples were acquired with
+  * @param  cal      calibration, offset in micro-g
+  * @param  in       raw samples (-128 .. 127)
+  * @param  out      calibrated samples
+  * @param  num      number of XYZ samples
   *
   */
-int32_t lis3de_acceleration_raw_get(const stmdev_ctx_t *ctx, int16_t *buff)
+void lis3de_from_fs_to_ug_cal_block(lis3de_fs_t fs,
+                                    const lis3de_cal_q_t *cal,
+                                    const int16_t *in, int32_t *out,
+                                    size_t num)
 {
-  int32_t ret;
-
-  int8_t dummy;
-  ret = lis3de_read_reg(ctx, LIS3DE_OUT_X, (uint8_t *)&dummy, 1);
-  buff[0] = dummy;
-
-  if (ret == 0)
+  int32_t sens = lis3de_fs_multiplier(fs, 0U);
+  int32_t k[9];
+  int32_t b[3];
+  int64_t acc;
+  const int16_t *raw;
+  size_t i;
+  uint8_t r;
+  uint8_t c;
+
+  for (r = 0U; r < 9U; r++)
   {
-    ret = lis3de_read_reg(ctx, LIS3DE_OUT_Y, (uint8_t *)&dummy, 1);
-    buff[1] = dummy;
+    /* truncation error below 1 micro-g per LSB */
+    k[r] = (int32_t)(((int64_t)cal->m_q14[r] * sens) / 16384);
   }
 
-  if (ret == 0)
+  for (r = 0U; r < 3U; r++)
   {
-    ret = lis3de_read_reg(ctx, LIS3DE_OUT_Z, (uint8_t *)&dummy, 1);
-    buff[2] = dummy;
+    acc = 0;
+
+    for (c = 0U; c < 3U; c++)
+    {
+      /* only the diagonal term when the matrix is not full */
+      if ((cal->full == PROPERTY_ENABLE) || (c == r))
+      {
+        acc += (int64_t)cal->m_q14[(r * 3U) + c] * cal->offset_ug[c];
+      }
+    }
+
+    b[r] = (int32_t)(acc / 16384);
   }
 
-  return ret;
+  for (i = 0U; i < num; i++)
+  {
+    raw = &in[i * 3U];
+
+    if (cal->full == PROPERTY_ENABLE)
+    {
+      out[i * 3U] = (k[0] * raw[0]) + (k[1] * raw[1]) + (k[2] * raw[2]) -
+                    b[0];
+      out[(i * 3U) + 1U] = (k[3] * raw[0]) + (k[4] * raw[1]) +
+                           (k[5] * raw[2]) - b[1];
+      out[(i * 3U) + 2U] = (k[6] * raw[0]) + (k[7] * raw[1]) +
+                           (k[8] * raw[2]) - b[2];
+    }
+
+    else
+    {
+      out[i * 3U] = (k[0] * raw[0]) - b[0];
+      out[(i * 3U) + 1U] = (k[4] * raw[1]) - b[1];
+      out[(i * 3U) + 2U] = (k[8] * raw[2]) - b[2];
+    }
+  }
 }
 
 /**
@@ -869,558 +1227,547 @@ int32_t lis3de_acceleration_raw_get(const stmdev_ctx_t *ctx, int16_t *buff)
   */
 
 /**
-  * @defgroup  LIS3DE_Common
-  * @brief     This section group common useful functions
+  * @defgroup  LIS3DE_Data_generation
+  * @brief     This section group all the functions concerning data generation.
   * @{
   *
   */
 
 /**
-  * @brief  DeviceWhoamI .[get]
+  * @brief  Temperature status register.[get]
   *
   * @param  ctx      read / write interface definitions
   * @param  buff     buffer that stores data read
   * @retval          interface status (MANDATORY: return 0 -> no Error)
   *
   */
-int32_t lis3de_device_id_get(const stmdev_ctx_t *ctx, uint8_t *buff)
+int32_t lis3de_temp_status_reg_get(const stmdev_ctx_t *ctx, uint8_t *buff)
 {
   int32_t ret;
 
-  ret = lis3de_read_reg(ctx, LIS3DE_WHO_AM_I, buff, 1);
+  ret = lis3de_read_reg(ctx, LIS3DE_STATUS_REG_AUX, buff, 1);
 
   return ret;
 }
 /**
-  * @brief  Self Test.[set]
+  * @brief  Temperature data available.[get]
   *
   * @param  ctx      read / write interface definitions
-  * @param  val      change the values of st in reg CTRL_REG4
+  * @param  val      change the values of tda in reg STATUS_REG_AUX
   * @retval          interface status (MANDATORY: return 0 -> no Error)
   *
   */
-int32_t lis3de_self_test_set(const stmdev_ctx_t *ctx, lis3de_st_t val)
+int32_t lis3de_temp_data_ready_get(const stmdev_ctx_t *ctx, uint8_t *val)
 {
-  lis3de_ctrl_reg4_t ctrl_reg4;
+  lis3de_status_reg_aux_t status_reg_aux;
   int32_t ret;
 
-  ret = lis3de_read_reg(ctx, LIS3DE_CTRL_REG4, (uint8_t *)&ctrl_reg4, 1);
-
-  if (ret == 0)
-  {
-    ctrl_reg4.st = (uint8_t)val;
-    ret = lis3de_write_reg(ctx, LIS3DE_CTRL_REG4, (uint8_t *)&ctrl_reg4, 1);
-  }
+  ret = lis3de_read_reg(ctx, LIS3DE_STATUS_REG_AUX,
+                        (uint8_t *)&status_reg_aux, 1);
+  *val = status_reg_aux._3da;
 
   return ret;
 }
-
 /**
-  * @brief  Self Test.[get]
+  * @brief  Temperature data overrun.[get]
   *
   * @param  ctx      read / write interface definitions
-  * @param  val      Get the values of st in reg CTRL_REG4
+  * @param  val      change the values of tor in reg STATUS_REG_AUX
   * @retval          interface status (MANDATORY: return 0 -> no Error)
   *
   */
-int32_t lis3de_self_test_get(const stmdev_ctx_t *ctx, lis3de_st_t *val)
+int32_t lis3de_temp_data_ovr_get(const stmdev_ctx_t *ctx, uint8_t *val)
 {
-  lis3de_ctrl_reg4_t ctrl_reg4;
+  lis3de_status_reg_aux_t status_reg_aux;
   int32_t ret;
 
-  ret = lis3de_read_reg(ctx, LIS3DE_CTRL_REG4, (uint8_t *)&ctrl_reg4, 1);
-
-  switch (ctrl_reg4.st)
-  {
-    case LIS3DE_ST_DISABLE:
-      *val = LIS3DE_ST_DISABLE;
-      break;
-
-    case LIS3DE_ST_POSITIVE:
-      *val = LIS3DE_ST_POSITIVE;
-      break;
-
-    case LIS3DE_ST_NEGATIVE:
-      *val = LIS3DE_ST_NEGATIVE;
-      break;
-
-    default:
-      *val = LIS3DE_ST_DISABLE;
-      break;
-  }
+  ret = lis3de_read_reg(ctx, LIS3DE_STATUS_REG_AUX,
+                        (uint8_t *)&status_reg_aux, 1);
+  *val = status_reg_aux._3or;
 
   return ret;
 }
-
 /**
-  * @brief  Reboot memory content. Reload the calibration parameters.[set]
+  * @brief  Temperature output value.[get]
   *
   * @param  ctx      read / write interface definitions
-  * @param  val      change the values of boot in reg CTRL_REG5
+  * @param  buff     buffer that stores data read
   * @retval          interface status (MANDATORY: return 0 -> no Error)
   *
   */
-int32_t lis3de_boot_set(const stmdev_ctx_t *ctx, uint8_t val)
+int32_t lis3de_temperature_raw_get(const stmdev_ctx_t *ctx, uint8_t *buff)
 {
-  lis3de_ctrl_reg5_t ctrl_reg5;
   int32_t ret;
 
-  ret = lis3de_read_reg(ctx, LIS3DE_CTRL_REG5, (uint8_t *)&ctrl_reg5, 1);
-
-  if (ret == 0)
-  {
-    ctrl_reg5.boot = val;
-    ret = lis3de_write_reg(ctx, LIS3DE_CTRL_REG5, (uint8_t *)&ctrl_reg5, 1);
-  }
+  ret = lis3de_read_reg(ctx, LIS3DE_OUT_ADC1_H, buff, 1);
 
   return ret;
 }
 
 /**
-  * @brief  Reboot memory content. Reload the calibration parameters.[get]
+  * @brief  ADC output value.[get]
+  *         Sample frequency: the same as the ODR CTRL_REG1
+  *         The resolution:
+  *                    10bit if LPen bit in CTRL_REG1 (20h) is clear
+  *                     8bit if LPen bit in CTRL_REG1 (20h) is set
+  *         Data Format:
+  *                     Outputs are Left Justified in 2’ complements
+  *                     range 800mV
+  *                     code zero means an analogue value of about 1.2V
+  *                     Voltage values smaller than centre values are positive
+  *                           (Example:  800mV = 7Fh / 127 dec)
+  *                     Voltage values bigger than centre values are negative
+  *                           (Example: 1600mV = 80h / -128 dec)
   *
   * @param  ctx      read / write interface definitions
-  * @param  val      change the values of boot in reg CTRL_REG5
+  * @param  buff     buffer that stores data read
   * @retval          interface status (MANDATORY: return 0 -> no Error)
   *
   */
-int32_t lis3de_boot_get(const stmdev_ctx_t *ctx, uint8_t *val)
+int32_t lis3de_adc_raw_get(const stmdev_ctx_t *ctx, int16_t *val)
 {
-  lis3de_ctrl_reg5_t ctrl_reg5;
+  uint8_t buff[6];
   int32_t ret;
 
-  ret = lis3de_read_reg(ctx, LIS3DE_CTRL_REG5, (uint8_t *)&ctrl_reg5, 1);
-  *val = (uint8_t)ctrl_reg5.boot;
+  ret = lis3de_read_reg(ctx, LIS3DE_OUT_ADC1_L, buff, 6);
+  val[0] = (int16_t)buff[1];
+  val[0] = (val[0] * 256) + (int16_t)buff[0];
+  val[1] = (int16_t)buff[3];
+  val[1] = (val[1] * 256) + (int16_t)buff[2];
+  val[2] = (int16_t)buff[5];
+  val[2] = (val[2] * 256) + (int16_t)buff[4];
 
   return ret;
 }
 
 /**
-  * @brief  Info about device status.[get]
+  * @brief  Auxiliary ADC.[set]
   *
   * @param  ctx      read / write interface definitions
-  * @param  val      register STATUS_REG
+  * @param  val      configure the auxiliary ADC
   * @retval          interface status (MANDATORY: return 0 -> no Error)
   *
   */
-int32_t lis3de_status_get(const stmdev_ctx_t *ctx, lis3de_status_reg_t *val)
+int32_t lis3de_aux_adc_set(const stmdev_ctx_t *ctx, lis3de_temp_en_t val)
 {
+  lis3de_temp_cfg_reg_t temp_cfg_reg;
   int32_t ret;
 
-  ret = lis3de_read_reg(ctx, LIS3DE_STATUS_REG, (uint8_t *) val, 1);
+  lis3de_lock(ctx);
 
-  return ret;
-}
-/**
-  * @}
-  *
-  */
+  ret = lis3de_read_reg(ctx, LIS3DE_TEMP_CFG_REG,
+                        (uint8_t *)&temp_cfg_reg, 1);
 
-/**
-  * @defgroup   LIS3DE_Interrupts_generator_1
-  * @brief      This section group all the functions that manage the first
-  *             interrupts generator
-  * @{
-  *
-  */
+  if (ret == 0)
+  {
+    if (val != LIS3DE_AUX_DISABLE)
+    {
+      /* Required in order to use auxiliary adc */
+      ret = lis3de_block_data_update_set(ctx, PROPERTY_ENABLE);
+    }
+  }
 
-/**
-  * @brief  Interrupt generator 1 configuration register.[set]
-  *
-  * @param  ctx      read / write interface definitions
-  * @param  val      register INT1_CFG
-  * @retval          interface status (MANDATORY: return 0 -> no Error)
-  *
-  */
-int32_t lis3de_int1_gen_conf_set(const stmdev_ctx_t *ctx,
-                                 lis3de_ig1_cfg_t *val)
-{
-  int32_t ret;
+  if (ret == 0)
+  {
+    temp_cfg_reg.temp_en = ((uint8_t) val & 0x02U) >> 1;
+    temp_cfg_reg.adc_pd  = (uint8_t) val &  0x01U;
+    ret = lis3de_write_reg(ctx, LIS3DE_TEMP_CFG_REG,
+                           (uint8_t *)&temp_cfg_reg, 1);
+  }
 
-  ret = lis3de_write_reg(ctx, LIS3DE_IG1_CFG, (uint8_t *) val, 1);
+  lis3de_unlock(ctx);
 
   return ret;
 }
 
 /**
-  * @brief  Interrupt generator 1 configuration register.[get]
+  * @brief  Auxiliary ADC.[get]
   *
   * @param  ctx      read / write interface definitions
-  * @param  val      register INT1_CFG
+  * @param  val      configure the auxiliary ADC
   * @retval          interface status (MANDATORY: return 0 -> no Error)
   *
   */
-int32_t lis3de_int1_gen_conf_get(const stmdev_ctx_t *ctx,
-                                 lis3de_ig1_cfg_t *val)
+int32_t lis3de_aux_adc_get(const stmdev_ctx_t *ctx, lis3de_temp_en_t *val)
 {
+  lis3de_temp_cfg_reg_t temp_cfg_reg;
   int32_t ret;
 
-  ret = lis3de_read_reg(ctx, LIS3DE_IG1_CFG, (uint8_t *) val, 1);
+  ret = lis3de_read_reg(ctx, LIS3DE_TEMP_CFG_REG,
+                        (uint8_t *)&temp_cfg_reg, 1);
 
-  return ret;
-}
+  if ((temp_cfg_reg.temp_en & temp_cfg_reg.adc_pd) ==
+      PROPERTY_ENABLE)
+  {
+    *val = LIS3DE_AUX_ON_TEMPERATURE;
+  }
 
-/**
-  * @brief  Interrupt generator 1 source register.[get]
-  *
-  * @param  ctx      read / write interface definitions
-  * @param  val      Registers INT1_SRC
-  * @retval          interface status (MANDATORY: return 0 -> no Error)
-  *
-  */
-int32_t lis3de_int1_gen_source_get(const stmdev_ctx_t *ctx,
-                                   lis3de_ig1_source_t *val)
-{
-  int32_t ret;
+  if ((temp_cfg_reg.temp_en  == PROPERTY_DISABLE) &&
+      (temp_cfg_reg.adc_pd == PROPERTY_ENABLE))
+  {
+    *val = LIS3DE_AUX_ON_PADS;
+  }
 
-  ret = lis3de_read_reg(ctx, LIS3DE_IG1_SOURCE, (uint8_t *) val, 1);
+  else
+  {
+    *val = LIS3DE_AUX_DISABLE;
+  }
 
   return ret;
 }
+
 /**
-  * @brief  User-defined threshold value for xl interrupt event on
-  *         generator 1.[set]
-  *         LSb = 16mg@2g / 32mg@4g / 62mg@8g / 186mg@16g
+  * @brief  Operating mode selection.[set]
   *
   * @param  ctx      read / write interface definitions
-  * @param  val      change the values of ths in reg INT1_THS
+  * @param  val      change the values of lpen in reg CTRL_REG1
   * @retval          interface status (MANDATORY: return 0 -> no Error)
   *
   */
-int32_t lis3de_int1_gen_threshold_set(const stmdev_ctx_t *ctx, uint8_t val)
+int32_t lis3de_operating_mode_set(const stmdev_ctx_t *ctx,
+                                  lis3de_op_md_t val)
 {
-  lis3de_ig1_ths_t int1_ths;
+  lis3de_ctrl_reg1_t ctrl_reg1;
   int32_t ret;
 
-  ret = lis3de_read_reg(ctx, LIS3DE_IG1_THS, (uint8_t *)&int1_ths, 1);
+  lis3de_lock(ctx);
+
+  ret = lis3de_read_reg(ctx, LIS3DE_CTRL_REG1, (uint8_t *)&ctrl_reg1, 1);
 
   if (ret == 0)
   {
-    int1_ths.ths = val;
-    ret = lis3de_write_reg(ctx, LIS3DE_IG1_THS, (uint8_t *)&int1_ths, 1);
+    ctrl_reg1.lpen = (uint8_t) val;
+    ret = lis3de_write_reg(ctx, LIS3DE_CTRL_REG1, (uint8_t *)&ctrl_reg1, 1);
   }
 
+  lis3de_unlock(ctx);
+
   return ret;
 }
 
 /**
-  * @brief  User-defined threshold value for xl interrupt event on
-  *         generator 1.[get]
-  *         LSb = 16mg@2g / 32mg@4g / 62mg@8g / 186mg@16g
+  * @brief  Operating mode selection.[get]
   *
   * @param  ctx      read / write interface definitions
-  * @param  val      change the values of ths in reg INT1_THS
+  * @param  val      change the values of lpen in reg CTRL_REG1
   * @retval          interface status (MANDATORY: return 0 -> no Error)
   *
   */
-int32_t lis3de_int1_gen_threshold_get(const stmdev_ctx_t *ctx, uint8_t *val)
+int32_t lis3de_operating_mode_get(const stmdev_ctx_t *ctx,
+                                  lis3de_op_md_t *val)
 {
-  lis3de_ig1_ths_t int1_ths;
+  lis3de_ctrl_reg1_t ctrl_reg1;
   int32_t ret;
 
-  ret = lis3de_read_reg(ctx, LIS3DE_IG1_THS, (uint8_t *)&int1_ths, 1);
-  *val = (uint8_t)int1_ths.ths;
+  ret = lis3de_read_reg(ctx, LIS3DE_CTRL_REG1, (uint8_t *)&ctrl_reg1, 1);
+
+  if (ret == 0)
+  {
+    if (ctrl_reg1.lpen == PROPERTY_ENABLE)
+    {
+      *val = LIS3DE_LP;
+    }
+
+    else
+    {
+      *val = LIS3DE_NM;
+    }
+  }
 
   return ret;
 }
 
 /**
-  * @brief  The minimum duration (LSb = 1/ODR) of the Interrupt 1 event to be
-  *         recognized.[set]
+  * @brief  Output data rate selection.[set]
   *
   * @param  ctx      read / write interface definitions
-  * @param  val      change the values of d in reg INT1_DURATION
+  * @param  val      change the values of odr in reg CTRL_REG1
   * @retval          interface status (MANDATORY: return 0 -> no Error)
   *
   */
-int32_t lis3de_int1_gen_duration_set(const stmdev_ctx_t *ctx, uint8_t val)
+int32_t lis3de_data_rate_set(const stmdev_ctx_t *ctx, lis3de_odr_t val)
 {
-  lis3de_ig1_duration_t int1_duration;
+  lis3de_ctrl_reg1_t ctrl_reg1;
   int32_t ret;
 
-  ret = lis3de_read_reg(ctx, LIS3DE_IG1_DURATION,
-                        (uint8_t *)&int1_duration, 1);
+  lis3de_lock(ctx);
+
+  ret = lis3de_read_reg(ctx, LIS3DE_CTRL_REG1, (uint8_t *)&ctrl_reg1, 1);
 
   if (ret == 0)
   {
-    int1_duration.d = val;
-    ret = lis3de_write_reg(ctx, LIS3DE_IG1_DURATION,
-                           (uint8_t *)&int1_duration, 1);
+    ctrl_reg1.odr = (uint8_t)val;
+    ret = lis3de_write_reg(ctx, LIS3DE_CTRL_REG1, (uint8_t *)&ctrl_reg1, 1);
   }
 
+  lis3de_unlock(ctx);
+
   return ret;
 }
 
 /**
-  * @brief  The minimum duration (LSb = 1/ODR) of the Interrupt 1 event to be
-  *         recognized.[get]
+  * @brief  Output data rate selection.[get]
   *
   * @param  ctx      read / write interface definitions
-  * @param  val      change the values of d in reg INT1_DURATION
+  * @param  val      get the values of odr in reg CTRL_REG1
   * @retval          interface status (MANDATORY: return 0 -> no Error)
   *
   */
-int32_t lis3de_int1_gen_duration_get(const stmdev_ctx_t *ctx, uint8_t *val)
+int32_t lis3de_data_rate_get(const stmdev_ctx_t *ctx, lis3de_odr_t *val)
 {
-  lis3de_ig1_duration_t int1_duration;
+  lis3de_ctrl_reg1_t ctrl_reg1;
   int32_t ret;
 
-  ret = lis3de_read_reg(ctx, LIS3DE_IG1_DURATION,
-                        (uint8_t *)&int1_duration, 1);
-  *val = (uint8_t)int1_duration.d;
-
-  return ret;
-}
+  ret = lis3de_read_reg(ctx, LIS3DE_CTRL_REG1, (uint8_t *)&ctrl_reg1, 1);
 
-/**
-  * @}
-  *
-  */
+  switch (ctrl_reg1.odr)
+  {
+    case LIS3DE_POWER_DOWN:
+      *val = LIS3DE_POWER_DOWN;
+      break;
 
-/**
-  * @defgroup   LIS3DE_Interrupts_generator_2
-  * @brief      This section group all the functions that manage the second
-  *             interrupts generator
-  * @{
-  *
-  */
+    case LIS3DE_ODR_1Hz:
+      *val = LIS3DE_ODR_1Hz;
+      break;
 
-/**
-  * @brief  Interrupt generator 2 configuration register.[set]
-  *
-  * @param  ctx      read / write interface definitions
-  * @param  val      registers IG2_CFG
-  * @retval          interface status (MANDATORY: return 0 -> no Error)
-  *
-  */
-int32_t lis3de_int2_gen_conf_set(const stmdev_ctx_t *ctx,
-                                 lis3de_ig2_cfg_t *val)
-{
-  int32_t ret;
+    case LIS3DE_ODR_10Hz:
+      *val = LIS3DE_ODR_10Hz;
+      break;
 
-  ret = lis3de_write_reg(ctx, LIS3DE_IG2_CFG, (uint8_t *) val, 1);
+    case LIS3DE_ODR_25Hz:
+      *val = LIS3DE_ODR_25Hz;
+      break;
 
-  return ret;
-}
+    case LIS3DE_ODR_50Hz:
+      *val = LIS3DE_ODR_50Hz;
+      break;
 
-/**
-  * @brief  Interrupt generator 2 configuration register.[get]
-  *
-  * @param  ctx      read / write interface definitions
-  * @param  val      registers IG2_CFG
-  * @retval          interface status (MANDATORY: return 0 -> no Error)
-  *
-  */
-int32_t lis3de_int2_gen_conf_get(const stmdev_ctx_t *ctx,
-                                 lis3de_ig2_cfg_t *val)
-{
-  int32_t ret;
+    case LIS3DE_ODR_100Hz:
+      *val = LIS3DE_ODR_100Hz;
+      break;
 
-  ret = lis3de_read_reg(ctx, LIS3DE_IG2_CFG, (uint8_t *) val, 1);
+    case LIS3DE_ODR_200Hz:
+      *val = LIS3DE_ODR_200Hz;
+      break;
 
-  return ret;
-}
-/**
-  * @brief  Interrupt generator 2 source register.[get]
-  *
-  * @param  ctx      read / write interface definitions
-  * @param  val      registers INT2_SRC
-  * @retval          interface status (MANDATORY: return 0 -> no Error)
-  *
-  */
-int32_t lis3de_int2_gen_source_get(const stmdev_ctx_t *ctx,
-                                   lis3de_ig2_source_t *val)
-{
-  int32_t ret;
+    case LIS3DE_ODR_400Hz:
+      *val = LIS3DE_ODR_400Hz;
+      break;
 
-  ret = lis3de_read_reg(ctx, LIS3DE_IG2_SOURCE, (uint8_t *) val, 1);
+    case LIS3DE_ODR_1kHz6:
+      *val = LIS3DE_ODR_1kHz6;
+      break;
+
+    case LIS3DE_ODR_5kHz376_LP_1kHz344_NM:
+      *val = LIS3DE_ODR_5kHz376_LP_1kHz344_NM;
+      break;
+
+    default:
+      *val = LIS3DE_POWER_DOWN;
+      break;
+  }
 
   return ret;
 }
+
 /**
-  * @brief   User-defined threshold value for xl interrupt event on
-  *          generator 2.[set]
-  *          LSb = 16mg@2g / 32mg@4g / 62mg@8g / 186mg@16g
+  * @brief   High pass data from internal filter sent to output register
+  *          and FIFO.
   *
   * @param  ctx      read / write interface definitions
-  * @param  val      change the values of ths in reg INT2_THS
+  * @param  val      change the values of fds in reg CTRL_REG2
   * @retval          interface status (MANDATORY: return 0 -> no Error)
   *
   */
-int32_t lis3de_int2_gen_threshold_set(const stmdev_ctx_t *ctx, uint8_t val)
+int32_t lis3de_high_pass_on_outputs_set(const stmdev_ctx_t *ctx,
+                                        uint8_t val)
 {
-  lis3de_ig2_ths_t int2_ths;
+  lis3de_ctrl_reg2_t ctrl_reg2;
   int32_t ret;
 
-  ret = lis3de_read_reg(ctx, LIS3DE_IG2_THS, (uint8_t *)&int2_ths, 1);
+  lis3de_lock(ctx);
+
+  ret = lis3de_read_reg(ctx, LIS3DE_CTRL_REG2, (uint8_t *)&ctrl_reg2, 1);
 
   if (ret == 0)
   {
-    int2_ths.ths = val;
-    ret = lis3de_write_reg(ctx, LIS3DE_IG2_THS, (uint8_t *)&int2_ths, 1);
+    ctrl_reg2.fds = val;
+    ret = lis3de_write_reg(ctx, LIS3DE_CTRL_REG2, (uint8_t *)&ctrl_reg2, 1);
   }
 
+  lis3de_unlock(ctx);
+
   return ret;
 }
 
 /**
-  * @brief  User-defined threshold value for xl interrupt event on
-  *         generator 2.[get]
-  *         LSb = 16mg@2g / 32mg@4g / 62mg@8g / 186mg@16g
+  * @brief   High pass data from internal filter sent to output register
+  *          and FIFO.[get]
   *
   * @param  ctx      read / write interface definitions
-  * @param  val      change the values of ths in reg INT2_THS
+  * @param  val      change the values of fds in reg CTRL_REG2
   * @retval          interface status (MANDATORY: return 0 -> no Error)
   *
   */
-int32_t lis3de_int2_gen_threshold_get(const stmdev_ctx_t *ctx, uint8_t *val)
+int32_t lis3de_high_pass_on_outputs_get(const stmdev_ctx_t *ctx,
+                                        uint8_t *val)
 {
-  lis3de_ig2_ths_t int2_ths;
+  lis3de_ctrl_reg2_t ctrl_reg2;
   int32_t ret;
 
-  ret = lis3de_read_reg(ctx, LIS3DE_IG2_THS, (uint8_t *)&int2_ths, 1);
-  *val = (uint8_t)int2_ths.ths;
+  ret = lis3de_read_reg(ctx, LIS3DE_CTRL_REG2, (uint8_t *)&ctrl_reg2, 1);
+  *val = (uint8_t)ctrl_reg2.fds;
 
   return ret;
 }
 
 /**
-  * @brief  The minimum duration (LSb = 1/ODR) of the Interrupt 1 event to be
-  *         recognized .[set]
+  * @brief   High-pass filter cutoff frequency selection.[set]
+  *
+  * HPCF[2:1]\ft @1Hz    @10Hz  @25Hz  @50Hz @100Hz @200Hz @400Hz @1kHz6 ft@5kHz
+  * AGGRESSIVE   0.02Hz  0.2Hz  0.5Hz  1Hz   2Hz    4Hz    8Hz    32Hz   100Hz
+  * STRONG       0.008Hz 0.08Hz 0.2Hz  0.5Hz 1Hz    2Hz    4Hz    16Hz   50Hz
+  * MEDIUM       0.004Hz 0.04Hz 0.1Hz  0.2Hz 0.5Hz  1Hz    2Hz    8Hz    25Hz
+  * LIGHT        0.002Hz 0.02Hz 0.05Hz 0.1Hz 0.2Hz  0.5Hz  1Hz    4Hz    12Hz
   *
   * @param  ctx      read / write interface definitions
-  * @param  val      change the values of d in reg INT2_DURATION
+  * @param  val      change the values of hpcf in reg CTRL_REG2
   * @retval          interface status (MANDATORY: return 0 -> no Error)
   *
   */
-int32_t lis3de_int2_gen_duration_set(const stmdev_ctx_t *ctx, uint8_t val)
+int32_t lis3de_high_pass_bandwidth_set(const stmdev_ctx_t *ctx,
+                                       lis3de_hpcf_t val)
 {
-  lis3de_ig2_duration_t int2_duration;
+  lis3de_ctrl_reg2_t ctrl_reg2;
   int32_t ret;
 
-  ret = lis3de_read_reg(ctx, LIS3DE_IG2_DURATION,
-                        (uint8_t *)&int2_duration, 1);
+  lis3de_lock(ctx);
+
+  ret = lis3de_read_reg(ctx, LIS3DE_CTRL_REG2, (uint8_t *)&ctrl_reg2, 1);
 
   if (ret == 0)
   {
-    int2_duration.d = val;
-    ret = lis3de_write_reg(ctx, LIS3DE_IG2_DURATION,
-                           (uint8_t *)&int2_duration, 1);
+    ctrl_reg2.hpcf = (uint8_t)val;
+    ret = lis3de_write_reg(ctx, LIS3DE_CTRL_REG2, (uint8_t *)&ctrl_reg2, 1);
   }
 
+  lis3de_unlock(ctx);
+
   return ret;
 }
 
 /**
-  * @brief  The minimum duration (LSb = 1/ODR) of the Interrupt 1 event to be
-  *         recognized.[get]
+  * @brief   High-pass filter cutoff frequency selection.[get]
+  *
+  * HPCF[2:1]\ft @1Hz    @10Hz  @25Hz  @50Hz @100Hz @200Hz @400Hz @1kHz6 ft@5kHz
+  * AGGRESSIVE   0.02Hz  0.2Hz  0.5Hz  1Hz   2Hz    4Hz    8Hz    32Hz   100Hz
+  * STRONG       0.008Hz 0.08Hz 0.2Hz  0.5Hz 1Hz    2Hz    4Hz    16Hz   50Hz
+  * MEDIUM       0.004Hz 0.04Hz 0.1Hz  0.2Hz 0.5Hz  1Hz    2Hz    8Hz    25Hz
+  * LIGHT        0.002Hz 0.02Hz 0.05Hz 0.1Hz 0.2Hz  0.5Hz  1Hz    4Hz    12Hz
   *
   * @param  ctx      read / write interface definitions
-  * @param  val      change the values of d in reg INT2_DURATION
+  * @param  val      get the values of hpcf in reg CTRL_REG2
   * @retval          interface status (MANDATORY: return 0 -> no Error)
   *
   */
-int32_t lis3de_int2_gen_duration_get(const stmdev_ctx_t *ctx, uint8_t *val)
+int32_t lis3de_high_pass_bandwidth_get(const stmdev_ctx_t *ctx,
+                                       lis3de_hpcf_t *val)
 {
-  lis3de_ig2_duration_t int2_duration;
+  lis3de_ctrl_reg2_t ctrl_reg2;
   int32_t ret;
 
-  ret = lis3de_read_reg(ctx, LIS3DE_IG2_DURATION,
-                        (uint8_t *)&int2_duration, 1);
-  *val = (uint8_t)int2_duration.d;
+  ret = lis3de_read_reg(ctx, LIS3DE_CTRL_REG2, (uint8_t *)&ctrl_reg2, 1);
 
-  return ret;
-}
+  switch (ctrl_reg2.hpcf)
+  {
+    case LIS3DE_AGGRESSIVE:
+      *val = LIS3DE_AGGRESSIVE;
+      break;
 
-/**
-  * @}
-  *
-  */
+    case LIS3DE_STRONG:
+      *val = LIS3DE_STRONG;
+      break;
 
-/**
-  * @defgroup  LIS3DE_Interrupt_pins
-  * @brief     This section group all the functions that manage interrupt pins
-  * @{
-  *
-  */
+    case LIS3DE_MEDIUM:
+      *val = LIS3DE_MEDIUM;
+      break;
+
+    case LIS3DE_LIGHT:
+      *val = LIS3DE_LIGHT;
+      break;
+
+    default:
+      *val = LIS3DE_LIGHT;
+      break;
+  }
+
+  return ret;
+}
 
 /**
-  * @brief  High-pass filter on interrupts/tap generator.[set]
+  * @brief  High-pass filter mode selection.[set]
   *
   * @param  ctx      read / write interface definitions
-  * @param  val      change the values of hp in reg CTRL_REG2
+  * @param  val      change the values of hpm in reg CTRL_REG2
   * @retval          interface status (MANDATORY: return 0 -> no Error)
   *
   */
-int32_t lis3de_high_pass_int_conf_set(const stmdev_ctx_t *ctx,
-                                      lis3de_hp_t val)
+int32_t lis3de_high_pass_mode_set(const stmdev_ctx_t *ctx, lis3de_hpm_t val)
 {
   lis3de_ctrl_reg2_t ctrl_reg2;
   int32_t ret;
 
+  lis3de_lock(ctx);
+
   ret = lis3de_read_reg(ctx, LIS3DE_CTRL_REG2, (uint8_t *)&ctrl_reg2, 1);
 
   if (ret == 0)
   {
-    ctrl_reg2.hp = (uint8_t)val;
+    ctrl_reg2.hpm = (uint8_t)val;
     ret = lis3de_write_reg(ctx, LIS3DE_CTRL_REG2, (uint8_t *)&ctrl_reg2, 1);
   }
 
+  lis3de_unlock(ctx);
+
   return ret;
 }
 
 /**
-  * @brief  High-pass filter on interrupts/tap generator.[get]
+  * @brief  High-pass filter mode selection.[get]
   *
   * @param  ctx      read / write interface definitions
-  * @param  val      Get the values of hp in reg CTRL_REG2
+  * @param  val      get the values of hpm in reg CTRL_REG2
   * @retval          interface status (MANDATORY: return 0 -> no Error)
   *
   */
-int32_t lis3de_high_pass_int_conf_get(const stmdev_ctx_t *ctx,
-                                      lis3de_hp_t *val)
+int32_t lis3de_high_pass_mode_get(const stmdev_ctx_t *ctx,
+                                  lis3de_hpm_t *val)
 {
   lis3de_ctrl_reg2_t ctrl_reg2;
   int32_t ret;
 
   ret = lis3de_read_reg(ctx, LIS3DE_CTRL_REG2, (uint8_t *)&ctrl_reg2, 1);
 
-  switch (ctrl_reg2.hp)
+  switch (ctrl_reg2.hpm)
   {
-    case LIS3DE_DISC_FROM_INT_GENERATOR:
-      *val = LIS3DE_DISC_FROM_INT_GENERATOR;
-      break;
-
-    case LIS3DE_ON_INT1_GEN:
-      *val = LIS3DE_ON_INT1_GEN;
-      break;
-
-    case LIS3DE_ON_INT2_GEN:
-      *val = LIS3DE_ON_INT2_GEN;
-      break;
-
-    case LIS3DE_ON_TAP_GEN:
-      *val = LIS3DE_ON_TAP_GEN;
-      break;
-
-    case LIS3DE_ON_INT1_INT2_GEN:
-      *val = LIS3DE_ON_INT1_INT2_GEN;
+    case LIS3DE_NORMAL_WITH_RST:
+      *val = LIS3DE_NORMAL_WITH_RST;
       break;
 
-    case LIS3DE_ON_INT1_TAP_GEN:
-      *val = LIS3DE_ON_INT1_TAP_GEN;
+    case LIS3DE_REFERENCE_MODE:
+      *val = LIS3DE_REFERENCE_MODE;
       break;
 
-    case LIS3DE_ON_INT2_TAP_GEN:
-      *val = LIS3DE_ON_INT2_TAP_GEN;
+    case LIS3DE_NORMAL:
+      *val = LIS3DE_NORMAL;
       break;
 
-    case LIS3DE_ON_INT1_INT2_TAP_GEN:
-      *val = LIS3DE_ON_INT1_INT2_TAP_GEN;
+    case LIS3DE_AUTORST_ON_INT:
+      *val = LIS3DE_AUTORST_ON_INT;
       break;
 
     default:
-      *val = LIS3DE_DISC_FROM_INT_GENERATOR;
+      *val = LIS3DE_NORMAL_WITH_RST;
       break;
   }
 
@@ -1428,611 +1775,769 @@ int32_t lis3de_high_pass_int_conf_get(const stmdev_ctx_t *ctx,
 }
 
 /**
-  * @brief  Int1 pin routing configuration register.[set]
+  * @brief  Full-scale configuration.[set]
   *
   * @param  ctx      read / write interface definitions
-  * @param  val      registers CTRL_REG3
+  * @param  val      change the values of fs in reg CTRL_REG4
   * @retval          interface status (MANDATORY: return 0 -> no Error)
   *
   */
-int32_t lis3de_pin_int1_config_set(const stmdev_ctx_t *ctx,
-                                   lis3de_ctrl_reg3_t *val)
+int32_t lis3de_full_scale_set(const stmdev_ctx_t *ctx, lis3de_fs_t val)
 {
+  lis3de_ctrl_reg4_t ctrl_reg4;
   int32_t ret;
 
-  ret = lis3de_write_reg(ctx, LIS3DE_CTRL_REG3, (uint8_t *) val, 1);
+  lis3de_lock(ctx);
 
-  return ret;
+  ret = lis3de_read_reg(ctx, LIS3DE_CTRL_REG4, (uint8_t *)&ctrl_reg4, 1);
+
+  if (ret == 0)
+  {
+    ctrl_reg4.fs = (uint8_t)val;
+    ret = lis3de_write_reg(ctx, LIS3DE_CTRL_REG4, (uint8_t *)&ctrl_reg4, 1);
+  }
+
+  lis3de_unlock(ctx);
+
+  return ret;
 }
 
 /**
-  * @brief  Int1 pin routing configuration register.[get]
+  * @brief  Full-scale configuration.[get]
   *
   * @param  ctx      read / write interface definitions
-  * @param  val      registers CTRL_REG3
+  * @param  val      get the values of fs in reg CTRL_REG4
   * @retval          interface status (MANDATORY: return 0 -> no Error)
   *
   */
-int32_t lis3de_pin_int1_config_get(const stmdev_ctx_t *ctx,
-                                   lis3de_ctrl_reg3_t *val)
+int32_t lis3de_full_scale_get(const stmdev_ctx_t *ctx, lis3de_fs_t *val)
 {
+  lis3de_ctrl_reg4_t ctrl_reg4;
   int32_t ret;
 
-  ret = lis3de_read_reg(ctx, LIS3DE_CTRL_REG3, (uint8_t *) val, 1);
+  ret = lis3de_read_reg(ctx, LIS3DE_CTRL_REG4, (uint8_t *)&ctrl_reg4, 1);
+
+  switch (ctrl_reg4.fs)
+  {
+    case LIS3DE_2g:
+      *val = LIS3DE_2g;
+      break;
+
+    case LIS3DE_4g:
+      *val = LIS3DE_4g;
+      break;
+
+    case LIS3DE_8g:
+      *val = LIS3DE_8g;
+      break;
+
+    case LIS3DE_16g:
+      *val = LIS3DE_16g;
+      break;
+
+    default:
+      *val = LIS3DE_2g;
+      break;
+  }
 
   return ret;
 }
+
 /**
-  * @brief  int2_pin_detect_4d: [set]  4D enable: 4D detection is enabled
-  *                                    on INT2 pin when 6D bit on
-  *                                    IG2_CFG (34h) is set to 1.
+  * @brief  Block Data Update.[set]
   *
   * @param  ctx      read / write interface definitions
-  * @param  val      change the values of d4d_ig2 in reg CTRL_REG5
+  * @param  val      change the values of bdu in reg CTRL_REG4
   * @retval          interface status (MANDATORY: return 0 -> no Error)
   *
   */
-int32_t lis3de_int2_pin_detect_4d_set(const stmdev_ctx_t *ctx, uint8_t val)
+int32_t lis3de_block_data_update_set(const stmdev_ctx_t *ctx, uint8_t val)
 {
-  lis3de_ctrl_reg5_t ctrl_reg5;
+  lis3de_ctrl_reg4_t ctrl_reg4;
   int32_t ret;
 
-  ret = lis3de_read_reg(ctx, LIS3DE_CTRL_REG5, (uint8_t *)&ctrl_reg5, 1);
+  lis3de_lock(ctx);
+
+  ret = lis3de_read_reg(ctx, LIS3DE_CTRL_REG4, (uint8_t *)&ctrl_reg4, 1);
 
   if (ret == 0)
   {
-    ctrl_reg5.d4d_ig2 = val;
-    ret = lis3de_write_reg(ctx, LIS3DE_CTRL_REG5, (uint8_t *)&ctrl_reg5, 1);
+    ctrl_reg4.bdu = val;
+    ret = lis3de_write_reg(ctx, LIS3DE_CTRL_REG4, (uint8_t *)&ctrl_reg4, 1);
   }
 
+  lis3de_unlock(ctx);
+
   return ret;
 }
 
 /**
-  * @brief  4D enable: 4D detection is enabled on INT2 pin when 6D bit on
-  *         IG2_CFG (34h) is set to 1.[get]
+  * @brief  Block Data Update.[get]
   *
   * @param  ctx      read / write interface definitions
-  * @param  val      change the values of d4d_ig2 in reg CTRL_REG5
+  * @param  val      change the values of bdu in reg CTRL_REG4
   * @retval          interface status (MANDATORY: return 0 -> no Error)
   *
   */
-int32_t lis3de_int2_pin_detect_4d_get(const stmdev_ctx_t *ctx, uint8_t *val)
+int32_t lis3de_block_data_update_get(const stmdev_ctx_t *ctx, uint8_t *val)
 {
-  lis3de_ctrl_reg5_t ctrl_reg5;
+  lis3de_ctrl_reg4_t ctrl_reg4;
   int32_t ret;
 
-  ret = lis3de_read_reg(ctx, LIS3DE_CTRL_REG5, (uint8_t *)&ctrl_reg5, 1);
-  *val = (uint8_t)ctrl_reg5.d4d_ig2;
+  ret = lis3de_read_reg(ctx, LIS3DE_CTRL_REG4, (uint8_t *)&ctrl_reg4, 1);
+  *val = (uint8_t)ctrl_reg4.bdu;
 
   return ret;
 }
 
 /**
-  * @brief   Latch interrupt request on INT2_SRC (35h) register, with
-  *          INT2_SRC (35h) register cleared by reading INT2_SRC(35h)
-  *          itself.[set]
+  * @brief  Reference value for interrupt generation.[set]
+  *         LSB = ~16@2g / ~31@4g / ~63@8g / ~127@16g
   *
   * @param  ctx      read / write interface definitions
-  * @param  val      change the values of lir_ig2 in reg CTRL_REG5
+  * @param  buff     buffer that contains data to write
   * @retval          interface status (MANDATORY: return 0 -> no Error)
   *
   */
-int32_t lis3de_int2_pin_notification_mode_set(const stmdev_ctx_t *ctx,
-                                              lis3de_lir_int2_t val)
+int32_t lis3de_filter_reference_set(const stmdev_ctx_t *ctx, uint8_t *buff)
 {
-  lis3de_ctrl_reg5_t ctrl_reg5;
   int32_t ret;
 
-  ret = lis3de_read_reg(ctx, LIS3DE_CTRL_REG5, (uint8_t *)&ctrl_reg5, 1);
-
-  if (ret == 0)
-  {
-    ctrl_reg5.lir_ig2 = (uint8_t)val;
-    ret = lis3de_write_reg(ctx, LIS3DE_CTRL_REG5, (uint8_t *)&ctrl_reg5, 1);
-  }
+  ret = lis3de_write_reg(ctx, LIS3DE_REFERENCE, buff, 1);
 
   return ret;
 }
 
 /**
-  * @brief   Latch interrupt request on INT2_SRC (35h) register, with
-  *          INT2_SRC (35h) register cleared by reading INT2_SRC(35h)
-  *          itself.[get]
+  * @brief  Reference value for interrupt generation.[get]
+  *         LSB = ~16@2g / ~31@4g / ~63@8g / ~127@16g
   *
   * @param  ctx      read / write interface definitions
-  * @param  val      Get the values of lir_ig2 in reg CTRL_REG5
+  * @param  buff     buffer that stores data read
   * @retval          interface status (MANDATORY: return 0 -> no Error)
   *
   */
-int32_t lis3de_int2_pin_notification_mode_get(const stmdev_ctx_t *ctx,
-                                              lis3de_lir_int2_t *val)
+int32_t lis3de_filter_reference_get(const stmdev_ctx_t *ctx, uint8_t *buff)
 {
-  lis3de_ctrl_reg5_t ctrl_reg5;
   int32_t ret;
 
-  ret = lis3de_read_reg(ctx, LIS3DE_CTRL_REG5, (uint8_t *)&ctrl_reg5, 1);
-
-  switch (ctrl_reg5.lir_ig2)
-  {
-    case LIS3DE_INT2_PULSED:
-      *val = LIS3DE_INT2_PULSED;
-      break;
-
-    case LIS3DE_INT2_LATCHED:
-      *val = LIS3DE_INT2_LATCHED;
-      break;
-
-    default:
-      *val = LIS3DE_INT2_PULSED;
-      break;
-  }
+  ret = lis3de_read_reg(ctx, LIS3DE_REFERENCE, buff, 1);
 
   return ret;
 }
-
 /**
-  * @brief  4D enable: 4D detection is enabled on INT1 pin when 6D bit
-  *                    on INT1_CFG(30h) is set to 1.[set]
+  * @brief  Acceleration set of data available.[get]
   *
   * @param  ctx      read / write interface definitions
-  * @param  val      change the values of d4d_ig1 in reg CTRL_REG5
+  * @param  val      change the values of zyxda in reg STATUS_REG
   * @retval          interface status (MANDATORY: return 0 -> no Error)
   *
   */
-int32_t lis3de_int1_pin_detect_4d_set(const stmdev_ctx_t *ctx, uint8_t val)
+int32_t lis3de_xl_data_ready_get(const stmdev_ctx_t *ctx, uint8_t *val)
 {
-  lis3de_ctrl_reg5_t ctrl_reg5;
+  lis3de_status_reg_t status_reg;
   int32_t ret;
 
-  ret = lis3de_read_reg(ctx, LIS3DE_CTRL_REG5, (uint8_t *)&ctrl_reg5, 1);
-
-  if (ret == 0)
-  {
-    ctrl_reg5.d4d_ig1 = val;
-    ret = lis3de_write_reg(ctx, LIS3DE_CTRL_REG5, (uint8_t *)&ctrl_reg5, 1);
-  }
+  ret = lis3de_read_reg(ctx, LIS3DE_STATUS_REG, (uint8_t *)&status_reg, 1);
+  *val = status_reg.zyxda;
 
   return ret;
 }
-
 /**
-  * @brief  4D enable: 4D detection is enabled on INT1 pin when 6D bit on
-  *         INT1_CFG(30h) is set to 1.[get]
+  * @brief  Acceleration set of data overrun.[get]
   *
   * @param  ctx      read / write interface definitions
-  * @param  val      change the values of d4d_ig1 in reg CTRL_REG5
+  * @param  val      change the values of zyxor in reg STATUS_REG
   * @retval          interface status (MANDATORY: return 0 -> no Error)
   *
   */
-int32_t lis3de_int1_pin_detect_4d_get(const stmdev_ctx_t *ctx, uint8_t *val)
+int32_t lis3de_xl_data_ovr_get(const stmdev_ctx_t *ctx, uint8_t *val)
 {
-  lis3de_ctrl_reg5_t ctrl_reg5;
+  lis3de_status_reg_t status_reg;
   int32_t ret;
 
-  ret = lis3de_read_reg(ctx, LIS3DE_CTRL_REG5, (uint8_t *)&ctrl_reg5, 1);
-  *val = (uint8_t)ctrl_reg5.d4d_ig1;
+  ret = lis3de_read_reg(ctx, LIS3DE_STATUS_REG, (uint8_t *)&status_reg, 1);
+  *val = status_reg.zyxor;
 
   return ret;
 }
-
 /**
-  * @brief   Latch interrupt request on INT1_SRC (31h), with INT1_SRC(31h)
-  *          register cleared by reading INT1_SRC (31h) itself.[set]
+  * @brief  Acceleration output value.[get]
+  *         When multi-byte access is enabled in the context (see
+  *         lis3de_priv_t) the three axes are read in a single burst
+  *         over OUT_X_L..OUT_Z, otherwise one register at a time.
   *
   * @param  ctx      read / write interface definitions
-  * @param  val      change the values of lir_ig1 in reg CTRL_REG5
+  * @param  buff     buffer that stores data read
   * @retval          interface status (MANDATORY: return 0 -> no Error)
   *
   */
-int32_t lis3de_int1_pin_notification_mode_set(const stmdev_ctx_t *ctx,
-                                              lis3de_lir_int1_t val)
+int32_t lis3de_acceleration_raw_get(const stmdev_ctx_t *ctx, int16_t *buff)
 {
-  lis3de_ctrl_reg5_t ctrl_reg5;
+  uint8_t inc = lis3de_multi_rw(ctx);
+  int8_t raw[6];
+  int8_t dummy;
   int32_t ret;
 
-  ret = lis3de_read_reg(ctx, LIS3DE_CTRL_REG5, (uint8_t *)&ctrl_reg5, 1);
+  if (inc != 0U)
+  {
+    ret = lis3de_read_reg(ctx, (uint8_t)(LIS3DE_OUT_X_L | inc),
+                          (uint8_t *)raw, 6);
+    buff[0] = raw[1];
+    buff[1] = raw[3];
+    buff[2] = raw[5];
+  }
 
-  if (ret == 0)
+  else
   {
-    ctrl_reg5.lir_ig1 = (uint8_t)val;
-    ret = lis3de_write_reg(ctx, LIS3DE_CTRL_REG5, (uint8_t *)&ctrl_reg5, 1);
+    lis3de_lock(ctx);
+
+    ret = lis3de_read_reg(ctx, LIS3DE_OUT_X, (uint8_t *)&dummy, 1);
+    buff[0] = dummy;
+
+    if (ret == 0)
+    {
+      ret = lis3de_read_reg(ctx, LIS3DE_OUT_Y, (uint8_t *)&dummy, 1);
+      buff[1] = dummy;
+    }
+
+    if (ret == 0)
+    {
+      ret = lis3de_read_reg(ctx, LIS3DE_OUT_Z, (uint8_t *)&dummy, 1);
+      buff[2] = dummy;
+    }
+
+    lis3de_unlock(ctx);
   }
 
   return ret;
 }
 
 /**
-  * @brief   Latch interrupt request on INT1_SRC (31h), with INT1_SRC(31h)
-  *          register cleared by reading INT1_SRC (31h) itself.[get]
+  * @brief  Status and acceleration sample record.[get]
+  *         With multi-byte access STATUS_REG and the outputs are read in
+  *         a single burst (27h..2Dh), so data-ready and overrun come for
+  *         free with the data.
   *
   * @param  ctx      read / write interface definitions
-  * @param  val      Get the values of lir_ig1 in reg CTRL_REG5
+  * @param  val      sample record, timestamped when a tick source is set
   * @retval          interface status (MANDATORY: return 0 -> no Error)
   *
   */
-int32_t lis3de_int1_pin_notification_mode_get(const stmdev_ctx_t *ctx,
-                                              lis3de_lir_int1_t *val)
+int32_t lis3de_sample_get(const stmdev_ctx_t *ctx, lis3de_sample_t *val)
 {
-  lis3de_ctrl_reg5_t ctrl_reg5;
+  uint8_t inc = lis3de_multi_rw(ctx);
+  lis3de_status_reg_t status_reg;
+  int8_t raw[7] = { 0 };
   int32_t ret;
 
-  ret = lis3de_read_reg(ctx, LIS3DE_CTRL_REG5, (uint8_t *)&ctrl_reg5, 1);
+  /* no flag reported when a read fails */
+  *(uint8_t *)&status_reg = 0x00U;
 
-  switch (ctrl_reg5.lir_ig1)
+  lis3de_lock(ctx);
+
+  val->timestamp = lis3de_tick(ctx);
+
+  if (inc != 0U)
   {
-    case LIS3DE_INT1_PULSED:
-      *val = LIS3DE_INT1_PULSED;
-      break;
+    ret = lis3de_read_reg(ctx, (uint8_t)(LIS3DE_STATUS_REG | inc),
+                          (uint8_t *)raw, 7);
+    *(uint8_t *)&status_reg = (uint8_t)raw[0];
+    val->xyz[0] = raw[2];
+    val->xyz[1] = raw[4];
+    val->xyz[2] = raw[6];
+  }
 
-    case LIS3DE_INT1_LATCHED:
-      *val = LIS3DE_INT1_LATCHED;
-      break;
+  else
+  {
+    ret = lis3de_read_reg(ctx, LIS3DE_STATUS_REG, (uint8_t *)&status_reg, 1);
 
-    default:
-      *val = LIS3DE_INT1_PULSED;
-      break;
+    if (ret == 0)
+    {
+      ret = lis3de_acceleration_raw_get(ctx, val->xyz);
+    }
   }
 
+  val->zyxda = status_reg.zyxda;
+  val->zyxor = status_reg.zyxor;
+
+  lis3de_unlock(ctx);
+
   return ret;
 }
 
 /**
-  * @brief  Int2 pin routing configuration register.[set]
+  * @}
+  *
+  */
+
+/**
+  * @defgroup  LIS3DE_Common
+  * @brief     This section group common useful functions
+  * @{
+  *
+  */
+
+/**
+  * @brief  DeviceWhoamI .[get]
   *
   * @param  ctx      read / write interface definitions
-  * @param  val      registers CTRL_REG6
+  * @param  buff     buffer that stores data read
   * @retval          interface status (MANDATORY: return 0 -> no Error)
   *
   */
-int32_t lis3de_pin_int2_config_set(const stmdev_ctx_t *ctx,
-                                   lis3de_ctrl_reg6_t *val)
+int32_t lis3de_device_id_get(const stmdev_ctx_t *ctx, uint8_t *buff)
 {
   int32_t ret;
 
-  ret = lis3de_write_reg(ctx, LIS3DE_CTRL_REG6, (uint8_t *) val, 1);
+  ret = lis3de_read_reg(ctx, LIS3DE_WHO_AM_I, buff, 1);
 
   return ret;
 }
-
 /**
-  * @brief  Int2 pin routing configuration register.[get]
+  * @brief  Self Test.[set]
   *
   * @param  ctx      read / write interface definitions
-  * @param  val      registers CTRL_REG6
+  * @param  val      change the values of st in reg CTRL_REG4
   * @retval          interface status (MANDATORY: return 0 -> no Error)
   *
   */
-int32_t lis3de_pin_int2_config_get(const stmdev_ctx_t *ctx,
-                                   lis3de_ctrl_reg6_t *val)
+int32_t lis3de_self_test_set(const stmdev_ctx_t *ctx, lis3de_st_t val)
 {
+  lis3de_ctrl_reg4_t ctrl_reg4;
   int32_t ret;
 
-  ret = lis3de_read_reg(ctx, LIS3DE_CTRL_REG6, (uint8_t *) val, 1);
+  lis3de_lock(ctx);
+
+  ret = lis3de_read_reg(ctx, LIS3DE_CTRL_REG4, (uint8_t *)&ctrl_reg4, 1);
+
+  if (ret == 0)
+  {
+    ctrl_reg4.st = (uint8_t)val;
+    ret = lis3de_write_reg(ctx, LIS3DE_CTRL_REG4, (uint8_t *)&ctrl_reg4, 1);
+  }
+
+  lis3de_unlock(ctx);
 
   return ret;
 }
-/**
-  * @}
-  *
-  */
 
 /**
-  * @defgroup  LIS3DE_Fifo
-  * @brief     This section group all the functions concerning the fifo usage
-  * @{
-  *
-  */
-
-/**
-  * @brief  FIFO enable.[set]
+  * @brief  Self Test.[get]
   *
   * @param  ctx      read / write interface definitions
-  * @param  val      change the values of fifo_en in reg CTRL_REG5
+  * @param  val      Get the values of st in reg CTRL_REG4
   * @retval          interface status (MANDATORY: return 0 -> no Error)
   *
   */
-int32_t lis3de_fifo_set(const stmdev_ctx_t *ctx, uint8_t val)
+int32_t lis3de_self_test_get(const stmdev_ctx_t *ctx, lis3de_st_t *val)
 {
-  lis3de_ctrl_reg5_t ctrl_reg5;
+  lis3de_ctrl_reg4_t ctrl_reg4;
   int32_t ret;
 
-  ret = lis3de_read_reg(ctx, LIS3DE_CTRL_REG5, (uint8_t *)&ctrl_reg5, 1);
+  ret = lis3de_read_reg(ctx, LIS3DE_CTRL_REG4, (uint8_t *)&ctrl_reg4, 1);
 
-  if (ret == 0)
+  switch (ctrl_reg4.st)
   {
-    ctrl_reg5.fifo_en = val;
-    ret = lis3de_write_reg(ctx, LIS3DE_CTRL_REG5, (uint8_t *)&ctrl_reg5, 1);
+    case LIS3DE_ST_DISABLE:
+      *val = LIS3DE_ST_DISABLE;
+      break;
+
+    case LIS3DE_ST_POSITIVE:
+      *val = LIS3DE_ST_POSITIVE;
+      break;
+
+    case LIS3DE_ST_NEGATIVE:
+      *val = LIS3DE_ST_NEGATIVE;
+      break;
+
+    default:
+      *val = LIS3DE_ST_DISABLE;
+      break;
   }
 
   return ret;
 }
 
 /**
-  * @brief  FIFO enable.[get]
+  * @brief  Average the FIFO content of a freshly restarted FIFO, at the
+  *         self-test configuration (400 Hz, 2 g).
   *
   * @param  ctx      read / write interface definitions
-  * @param  val      change the values of fifo_en in reg CTRL_REG5
-  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  * @param  mg       X, Y, Z averages in mg
+  * @retval          interface status, -1 if the FIFO did not fill
   *
   */
-int32_t lis3de_fifo_get(const stmdev_ctx_t *ctx, uint8_t *val)
+static int32_t lis3de_st_average(const stmdev_ctx_t *ctx, int32_t *mg)
 {
-  lis3de_ctrl_reg5_t ctrl_reg5;
+  lis3de_fifo_src_reg_t fifo_src_reg;
+  int16_t xyz[3U * LIS3DE_ST_SAMPLES];
+  uint32_t waited = LIS3DE_ST_FILL_MS;
+  uint8_t count = 0U;
+  uint8_t axis;
+  uint8_t i;
+  int32_t sum;
+  int32_t div = 10 * (int32_t)LIS3DE_ST_SAMPLES;
   int32_t ret;
 
-  ret = lis3de_read_reg(ctx, LIS3DE_CTRL_REG5, (uint8_t *)&ctrl_reg5, 1);
-  *val = (uint8_t)ctrl_reg5.fifo_en;
+  /* only samples taken after the restart are averaged */
+  ret = lis3de_fifo_mode_set(ctx, LIS3DE_BYPASS_MODE);
 
-  return ret;
-}
+  if (ret == 0)
+  {
+    ret = lis3de_fifo_mode_set(ctx, LIS3DE_FIFO_MODE);
+  }
 
-/**
-  * @brief  FIFO watermark level selection.[set]
-  *
-  * @param  ctx      read / write interface definitions
-  * @param  val      change the values of fth in reg FIFO_CTRL_REG
-  * @retval          interface status (MANDATORY: return 0 -> no Error)
-  *
-  */
-int32_t lis3de_fifo_watermark_set(const stmdev_ctx_t *ctx, uint8_t val)
-{
-  lis3de_fifo_ctrl_reg_t fifo_ctrl_reg;
-  int32_t ret;
+  if (ret == 0)
+  {
+    ctx->mdelay(LIS3DE_ST_FILL_MS);
+    ret = lis3de_fifo_status_get(ctx, &fifo_src_reg);
+  }
 
-  ret = lis3de_read_reg(ctx, LIS3DE_FIFO_CTRL_REG,
-                        (uint8_t *)&fifo_ctrl_reg, 1);
+  /* a slow ODR within tolerance only delays the fill */
+  while ((ret == 0) && (waited < LIS3DE_ST_FILL_MAX_MS) &&
+         (fifo_src_reg.ovrn_fifo == PROPERTY_DISABLE) &&
+         (fifo_src_reg.fss < LIS3DE_ST_SAMPLES))
+  {
+    ctx->mdelay(1U);
+    waited++;
+    ret = lis3de_fifo_status_get(ctx, &fifo_src_reg);
+  }
 
   if (ret == 0)
   {
-    fifo_ctrl_reg.fth = val;
-    ret = lis3de_write_reg(ctx, LIS3DE_FIFO_CTRL_REG,
-                           (uint8_t *)&fifo_ctrl_reg, 1);
+    ret = lis3de_fifo_read_batch(ctx, xyz, LIS3DE_ST_SAMPLES, &count);
   }
 
-  return ret;
-}
+  if ((ret == 0) && (count < LIS3DE_ST_SAMPLES))
+  {
+    ret = -1;
+  }
 
-/**
-  * @brief  FIFO watermark level selection.[get]
-  *
-  * @param  ctx      read / write interface definitions
-  * @param  val      change the values of fth in reg FIFO_CTRL_REG
-  * @retval          interface status (MANDATORY: return 0 -> no Error)
-  *
-  */
-int32_t lis3de_fifo_watermark_get(const stmdev_ctx_t *ctx, uint8_t *val)
-{
-  lis3de_fifo_ctrl_reg_t fifo_ctrl_reg;
-  int32_t ret;
+  for (axis = 0U; (axis < 3U) && (ret == 0); axis++)
+  {
+    sum = 0;
 
-  ret = lis3de_read_reg(ctx, LIS3DE_FIFO_CTRL_REG,
-                        (uint8_t *)&fifo_ctrl_reg, 1);
-  *val = (uint8_t)fifo_ctrl_reg.fth;
+    for (i = 0U; i < LIS3DE_ST_SAMPLES; i++)
+    {
+      sum += xyz[((uint16_t)i * 3U) + axis];
+    }
+
+    /* 15.6 mg/LSB */
+    sum *= 156;
+    mg[axis] = (sum >= 0) ? ((sum + (div / 2)) / div) :
+               -(((div / 2) - sum) / div);
+  }
 
   return ret;
 }
 
 /**
-  * @brief  Trigger FIFO selection.[set]
+  * @brief  Run the self-test procedure and estimate the zero-g offset.
+  *         The configuration (CTRL_REG1 .. CTRL_REG6, FIFO_CTRL_REG) is
+  *         saved, the device is sampled at 400 Hz, 2 g, through the FIFO
+  *         with and without positive self-test, and the configuration is
+  *         restored, also on error. ctx->mdelay is called only for the
+  *         LIS3DE_ST_SETTLE_MS settling times and the FIFO fill wait
+  *         (nominal time, then 1 ms polls up to LIS3DE_ST_FILL_MAX_MS).
+  *         The offset assumes the device at rest in any orthogonal
+  *         position: 1 g is removed from the axis reading gravity.
   *
   * @param  ctx      read / write interface definitions
-  * @param  val      change the values of tr in reg FIFO_CTRL_REG
-  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  * @param  val      averages, self-test change, offset and verdict
+  * @retval          interface status, -1 if mdelay is not available
   *
   */
-int32_t lis3de_fifo_trigger_event_set(const stmdev_ctx_t *ctx,
-                                      lis3de_tr_t val)
+int32_t lis3de_self_test_run(const stmdev_ctx_t *ctx,
+                             lis3de_st_result_t *val)
 {
   lis3de_fifo_ctrl_reg_t fifo_ctrl_reg;
+  lis3de_ctrl_reg1_t ctrl_reg1;
+  lis3de_ctrl_reg4_t ctrl_reg4;
+  lis3de_ctrl_reg5_t ctrl_reg5;
+  lis3de_ctrl_reg6_t ctrl_reg6;
+  lis3de_ctrl_reg6_t test_reg6;
+  uint8_t saved[6];              /* CTRL_REG1 .. CTRL_REG6 */
+  uint8_t test[6];               /* CTRL_REG1 .. CTRL_REG6 */
+  uint8_t grav = 0U;
+  uint8_t axis;
+  int32_t delta;
   int32_t ret;
+  int32_t err;
 
-  ret = lis3de_read_reg(ctx, LIS3DE_FIFO_CTRL_REG,
-                        (uint8_t *)&fifo_ctrl_reg, 1);
+  if (ctx->mdelay == NULL)
+  {
+    return -1;
+  }
+
+  lis3de_lock(ctx);
+
+  ret = lis3de_read_regs(ctx, LIS3DE_CTRL_REG1, saved, 6);
 
   if (ret == 0)
   {
-    fifo_ctrl_reg.tr = (uint8_t)val;
-    ret = lis3de_write_reg(ctx, LIS3DE_FIFO_CTRL_REG,
-                           (uint8_t *)&fifo_ctrl_reg, 1);
+    ret = lis3de_read_reg(ctx, LIS3DE_FIFO_CTRL_REG,
+                          (uint8_t *)&fifo_ctrl_reg, 1);
   }
 
-  return ret;
-}
+  if (ret == 0)
+  {
+    *(uint8_t *)&ctrl_reg1 = 0U;
+    ctrl_reg1.odr = (uint8_t)LIS3DE_ODR_400Hz;
+    ctrl_reg1.xen = PROPERTY_ENABLE;
+    ctrl_reg1.yen = PROPERTY_ENABLE;
+    ctrl_reg1.zen = PROPERTY_ENABLE;
+    /* SPI mode bit is kept */
+    *(uint8_t *)&ctrl_reg4 = saved[3];
+    ctrl_reg4.bdu = PROPERTY_ENABLE;
+    ctrl_reg4.fs = (uint8_t)LIS3DE_2g;
+    ctrl_reg4.st = (uint8_t)LIS3DE_ST_DISABLE;
+    *(uint8_t *)&ctrl_reg5 = saved[4];
+    ctrl_reg5.fifo_en = PROPERTY_ENABLE;
+    ctrl_reg5.boot = PROPERTY_DISABLE;
+    /* INT2 routing, activity and polarity cleared, reserved bits kept */
+    *(uint8_t *)&ctrl_reg6 = saved[5];
+    *(uint8_t *)&test_reg6 = 0U;
+    test_reg6.not_used_01 = ctrl_reg6.not_used_01;
+    test_reg6.not_used_02 = ctrl_reg6.not_used_02;
+    test[0] = *(uint8_t *)&ctrl_reg1;
+    test[1] = 0U;                /* high-pass filter off */
+    test[2] = 0U;                /* no INT1 source during the test */
+    test[3] = *(uint8_t *)&ctrl_reg4;
+    test[4] = *(uint8_t *)&ctrl_reg5;
+    test[5] = *(uint8_t *)&test_reg6;
+    ret = lis3de_write_regs(ctx, LIS3DE_CTRL_REG1, test, 6);
+  }
 
-/**
-  * @brief  Trigger FIFO selection.[get]
-  *
-  * @param  ctx      read / write interface definitions
-  * @param  val      Get the values of tr in reg FIFO_CTRL_REG
-  * @retval          interface status (MANDATORY: return 0 -> no Error)
-  *
-  */
-int32_t lis3de_fifo_trigger_event_get(const stmdev_ctx_t *ctx,
-                                      lis3de_tr_t *val)
-{
-  lis3de_fifo_ctrl_reg_t fifo_ctrl_reg;
-  int32_t ret;
+  if (ret == 0)
+  {
+    ctx->mdelay(LIS3DE_ST_SETTLE_MS);
+    ret = lis3de_st_average(ctx, val->nost_mg);
+  }
 
-  ret = lis3de_read_reg(ctx, LIS3DE_FIFO_CTRL_REG,
-                        (uint8_t *)&fifo_ctrl_reg, 1);
+  if (ret == 0)
+  {
+    ret = lis3de_self_test_set(ctx, LIS3DE_ST_POSITIVE);
+  }
 
-  switch (fifo_ctrl_reg.tr)
+  if (ret == 0)
   {
-    case LIS3DE_INT1_GEN:
-      *val = LIS3DE_INT1_GEN;
-      break;
+    ctx->mdelay(LIS3DE_ST_SETTLE_MS);
+    ret = lis3de_st_average(ctx, val->st_mg);
+  }
 
-    case LIS3DE_INT2_GEN:
-      *val = LIS3DE_INT2_GEN;
-      break;
+  /* restore the configuration, self-test off, FIFO restarted */
+  err = lis3de_fifo_mode_set(ctx, LIS3DE_BYPASS_MODE);
 
-    default:
-      *val = LIS3DE_INT1_GEN;
-      break;
+  if (err == 0)
+  {
+    err = lis3de_write_regs(ctx, LIS3DE_CTRL_REG1, saved, 6);
   }
 
-  return ret;
-}
+  if (err == 0)
+  {
+    err = lis3de_write_reg(ctx, LIS3DE_FIFO_CTRL_REG,
+                           (uint8_t *)&fifo_ctrl_reg, 1);
+  }
 
-/**
-  * @brief  FIFO mode selection.[set]
-  *
-  * @param  ctx      read / write interface definitions
-  * @param  val      change the values of fm in reg FIFO_CTRL_REG
-  * @retval          interface status (MANDATORY: return 0 -> no Error)
-  *
-  */
-int32_t lis3de_fifo_mode_set(const stmdev_ctx_t *ctx, lis3de_fm_t val)
-{
-  lis3de_fifo_ctrl_reg_t fifo_ctrl_reg;
-  int32_t ret;
+  if (ret == 0)
+  {
+    ret = err;
+  }
 
-  ret = lis3de_read_reg(ctx, LIS3DE_FIFO_CTRL_REG,
-                        (uint8_t *)&fifo_ctrl_reg, 1);
+  lis3de_unlock(ctx);
 
   if (ret == 0)
   {
-    fifo_ctrl_reg.fm = (uint8_t)val;
-    ret = lis3de_write_reg(ctx, LIS3DE_FIFO_CTRL_REG,
-                           (uint8_t *)&fifo_ctrl_reg, 1);
+    val->pass = PROPERTY_ENABLE;
+
+    for (axis = 0U; axis < 3U; axis++)
+    {
+      val->delta_mg[axis] = val->st_mg[axis] - val->nost_mg[axis];
+      delta = (val->delta_mg[axis] >= 0) ? val->delta_mg[axis] :
+              -val->delta_mg[axis];
+
+      if ((delta < LIS3DE_ST_MIN_MG) || (delta > LIS3DE_ST_MAX_MG))
+      {
+        val->pass = PROPERTY_DISABLE;
+      }
+
+      val->offset_mg[axis] = val->nost_mg[axis];
+
+      if ((val->nost_mg[axis] * val->nost_mg[axis]) >
+          (val->nost_mg[grav] * val->nost_mg[grav]))
+      {
+        grav = axis;
+      }
+    }
+
+    val->offset_mg[grav] -= (val->nost_mg[grav] >= 0) ? 1000 : -1000;
   }
 
   return ret;
 }
 
 /**
-  * @brief  FIFO mode selection.[get]
+  * @brief  Reboot memory content. Reload the calibration parameters.[set]
+  *         The shadow cache, if any, is invalidated.
   *
   * @param  ctx      read / write interface definitions
-  * @param  val      Get the values of fm in reg FIFO_CTRL_REG
+  * @param  val      change the values of boot in reg CTRL_REG5
   * @retval          interface status (MANDATORY: return 0 -> no Error)
   *
   */
-int32_t lis3de_fifo_mode_get(const stmdev_ctx_t *ctx, lis3de_fm_t *val)
+int32_t lis3de_boot_set(const stmdev_ctx_t *ctx, uint8_t val)
 {
-  lis3de_fifo_ctrl_reg_t fifo_ctrl_reg;
+  lis3de_shadow_t *shadow = lis3de_shadow(ctx);
+  lis3de_ctrl_reg5_t ctrl_reg5;
   int32_t ret;
 
-  ret = lis3de_read_reg(ctx, LIS3DE_FIFO_CTRL_REG,
-                        (uint8_t *)&fifo_ctrl_reg, 1);
-
-  switch (fifo_ctrl_reg.fm)
-  {
-    case LIS3DE_BYPASS_MODE:
-      *val = LIS3DE_BYPASS_MODE;
-      break;
-
-    case LIS3DE_FIFO_MODE:
-      *val = LIS3DE_FIFO_MODE;
-      break;
+  lis3de_lock(ctx);
 
-    case LIS3DE_DYNAMIC_STREAM_MODE:
-      *val = LIS3DE_DYNAMIC_STREAM_MODE;
-      break;
+  ret = lis3de_read_reg(ctx, LIS3DE_CTRL_REG5, (uint8_t *)&ctrl_reg5, 1);
 
-    case LIS3DE_STREAM_TO_FIFO_MODE:
-      *val = LIS3DE_STREAM_TO_FIFO_MODE;
-      break;
+  if (ret == 0)
+  {
+    ctrl_reg5.boot = val;
+    ret = lis3de_write_reg(ctx, LIS3DE_CTRL_REG5, (uint8_t *)&ctrl_reg5, 1);
+  }
 
-    default:
-      *val = LIS3DE_BYPASS_MODE;
-      break;
+  /* registers are reloaded: cache needs lis3de_shadow_sync */
+  if (shadow != NULL)
+  {
+    shadow->valid = PROPERTY_DISABLE;
   }
 
+  lis3de_unlock(ctx);
+
   return ret;
 }
 
 /**
-  * @brief  FIFO status register.[get]
+  * @brief  Reboot memory content. Reload the calibration parameters.[get]
   *
   * @param  ctx      read / write interface definitions
-  * @param  val      registers FIFO_SRC_REG
+  * @param  val      change the values of boot in reg CTRL_REG5
   * @retval          interface status (MANDATORY: return 0 -> no Error)
   *
   */
-int32_t lis3de_fifo_status_get(const stmdev_ctx_t *ctx,
-                               lis3de_fifo_src_reg_t *val)
+int32_t lis3de_boot_get(const stmdev_ctx_t *ctx, uint8_t *val)
 {
+  lis3de_ctrl_reg5_t ctrl_reg5;
   int32_t ret;
 
-  ret = lis3de_read_reg(ctx, LIS3DE_FIFO_SRC_REG, (uint8_t *) val, 1);
+  ret = lis3de_read_reg(ctx, LIS3DE_CTRL_REG5, (uint8_t *)&ctrl_reg5, 1);
+  *val = (uint8_t)ctrl_reg5.boot;
 
   return ret;
 }
+
 /**
-  * @brief  FIFO stored data level.[get]
+  * @brief  Info about device status.[get]
   *
   * @param  ctx      read / write interface definitions
-  * @param  val      change the values of fss in reg FIFO_SRC_REG
+  * @param  val      register STATUS_REG
   * @retval          interface status (MANDATORY: return 0 -> no Error)
   *
   */
-int32_t lis3de_fifo_data_level_get(const stmdev_ctx_t *ctx, uint8_t *val)
+int32_t lis3de_status_get(const stmdev_ctx_t *ctx, lis3de_status_reg_t *val)
 {
-  lis3de_fifo_src_reg_t fifo_src_reg;
   int32_t ret;
 
-  ret = lis3de_read_reg(ctx, LIS3DE_FIFO_SRC_REG,
-                        (uint8_t *)&fifo_src_reg, 1);
-  *val = (uint8_t)fifo_src_reg.fss;
+  ret = lis3de_read_reg(ctx, LIS3DE_STATUS_REG, (uint8_t *) val, 1);
 
   return ret;
 }
+
 /**
-  * @brief  Empty FIFO status flag.[get]
+  * @brief  Check if a UCF line would rewrite the value already held in a
+  *         valid shadow cache.
   *
   * @param  ctx      read / write interface definitions
-  * @param  val      change the values of empty in reg FIFO_SRC_REG
-  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  * @param  line     address / data pair
+  * @retval          1 if the write can be dropped, 0 otherwise
   *
   */
-int32_t lis3de_fifo_empty_flag_get(const stmdev_ctx_t *ctx, uint8_t *val)
+static uint8_t lis3de_ucf_redundant(const stmdev_ctx_t *ctx,
+                                    const ucf_line_t *line)
 {
-  lis3de_fifo_src_reg_t fifo_src_reg;
-  int32_t ret;
+  const lis3de_shadow_t *shadow = lis3de_shadow(ctx);
+  uint8_t skip = 0U;
 
-  ret = lis3de_read_reg(ctx, LIS3DE_FIFO_SRC_REG,
-                        (uint8_t *)&fifo_src_reg, 1);
-  *val = (uint8_t)fifo_src_reg.empty;
+  if ((shadow != NULL) && (shadow->valid == PROPERTY_ENABLE) &&
+      (shadow->staging == PROPERTY_DISABLE) &&
+      (lis3de_shadow_reg(line->address) == 1U) &&
+      (shadow->reg[line->address - LIS3DE_TEMP_CFG_REG] == line->data))
+  {
+    skip = 1U;
+  }
 
-  return ret;
+  return skip;
 }
+
 /**
-  * @brief  FIFO overrun status flag.[get]
+  * @brief  Load a configuration made of address / data pairs (e.g.
+  *         generated by Unico). Lines on consecutive addresses are
+  *         written in one burst with multi-byte access, and lines
+  *         matching a valid shadow cache are dropped.
   *
   * @param  ctx      read / write interface definitions
-  * @param  val      change the values of ovrn_fifo in reg FIFO_SRC_REG
+  * @param  lines    configuration to load
+  * @param  n        number of lines
   * @retval          interface status (MANDATORY: return 0 -> no Error)
   *
   */
-int32_t lis3de_fifo_ovr_flag_get(const stmdev_ctx_t *ctx, uint8_t *val)
+int32_t lis3de_ucf_load(const stmdev_ctx_t *ctx, const ucf_line_t *lines,
+                        size_t n)
 {
-  lis3de_fifo_src_reg_t fifo_src_reg;
-  int32_t ret;
+  uint8_t inc = lis3de_multi_rw(ctx);
+  uint8_t buff[LIS3DE_UCF_BURST_MAX];
+  uint8_t first = 0U;
+  uint16_t len = 0U;
+  size_t i;
+  int32_t ret = 0;
 
-  ret = lis3de_read_reg(ctx, LIS3DE_FIFO_SRC_REG,
-                        (uint8_t *)&fifo_src_reg, 1);
-  *val = (uint8_t)fifo_src_reg.ovrn_fifo;
+  lis3de_lock(ctx);
 
-  return ret;
-}
-/**
-  * @brief  FIFO watermark status.[get]
-  *
-  * @param  ctx      read / write interface definitions
-  * @param  val      change the values of wtm in reg FIFO_SRC_REG
-  * @retval          interface status (MANDATORY: return 0 -> no Error)
-  *
-  */
-int32_t lis3de_fifo_fth_flag_get(const stmdev_ctx_t *ctx, uint8_t *val)
-{
-  lis3de_fifo_src_reg_t fifo_src_reg;
-  int32_t ret;
+  for (i = 0U; (i < n) && (ret == 0); i++)
+  {
+    /* a line rewriting the pending run is compared after the flush */
+    if ((len > 0U) && (lines[i].address >= first) &&
+        (lines[i].address < (first + len)))
+    {
+      ret = lis3de_write_reg(ctx, (len == 1U) ? first :
+                             (uint8_t)(first | inc), buff, len);
+      len = 0U;
+    }
 
-  ret = lis3de_read_reg(ctx, LIS3DE_FIFO_SRC_REG,
-                        (uint8_t *)&fifo_src_reg, 1);
-  *val = (uint8_t)fifo_src_reg.wtm;
+    if ((ret == 0) && (lis3de_ucf_redundant(ctx, &lines[i]) == 0U))
+    {
+      /* flush the pending run unless this line extends it */
+      if ((len > 0U) && ((inc == 0U) || (len == LIS3DE_UCF_BURST_MAX) ||
+                         (lines[i].address != (uint8_t)(first + len))))
+      {
+        ret = lis3de_write_reg(ctx, (len == 1U) ? first :
+                               (uint8_t)(first | inc), buff, len);
+        len = 0U;
+      }
+
+      if (len == 0U)
+      {
+        first = lines[i].address;
+      }
+
+      buff[len] = lines[i].data;
+      len++;
+    }
+  }
+
+  if ((ret == 0) && (len > 0U))
+  {
+    ret = lis3de_write_reg(ctx, (len == 1U) ? first :
+                           (uint8_t)(first | inc), buff, len);
+  }
+
+  lis3de_unlock(ctx);
 
   return ret;
 }
@@ -2042,429 +2547,4730 @@ int32_t lis3de_fifo_fth_flag_get(const stmdev_ctx_t *ctx, uint8_t *val)
   */
 
 /**
-  * @defgroup  LIS3DE_Tap_generator
-  * @brief     This section group all the functions that manage the tap and
-  *            double tap event generation
+  * @defgroup   LIS3DE_Interrupts_generator_1
+  * @brief      This section group all the functions that manage the first
+  *             interrupts generator
   * @{
   *
   */
 
 /**
-  * @brief  Tap/Double Tap generator configuration register.[set]
+  * @brief  Interrupt generator 1 configuration register.[set]
   *
   * @param  ctx      read / write interface definitions
-  * @param  val      registers CLICK_CFG
+  * @param  val      register INT1_CFG
   * @retval          interface status (MANDATORY: return 0 -> no Error)
   *
   */
-int32_t lis3de_tap_conf_set(const stmdev_ctx_t *ctx,
-                            lis3de_click_cfg_t *val)
+int32_t lis3de_int1_gen_conf_set(const stmdev_ctx_t *ctx,
+                                 lis3de_ig1_cfg_t *val)
 {
   int32_t ret;
 
-  ret = lis3de_write_reg(ctx, LIS3DE_CLICK_CFG, (uint8_t *) val, 1);
+  ret = lis3de_write_reg(ctx, LIS3DE_IG1_CFG, (uint8_t *) val, 1);
 
   return ret;
 }
 
 /**
-  * @brief  Tap/Double Tap generator configuration register.[get]
+  * @brief  Interrupt generator 1 configuration register.[get]
   *
   * @param  ctx      read / write interface definitions
-  * @param  val      registers CLICK_CFG
+  * @param  val      register INT1_CFG
   * @retval          interface status (MANDATORY: return 0 -> no Error)
   *
   */
-int32_t lis3de_tap_conf_get(const stmdev_ctx_t *ctx,
-                            lis3de_click_cfg_t *val)
+int32_t lis3de_int1_gen_conf_get(const stmdev_ctx_t *ctx,
+                                 lis3de_ig1_cfg_t *val)
 {
   int32_t ret;
 
-  ret = lis3de_read_reg(ctx, LIS3DE_CLICK_CFG, (uint8_t *) val, 1);
+  ret = lis3de_read_reg(ctx, LIS3DE_IG1_CFG, (uint8_t *) val, 1);
 
   return ret;
 }
+
 /**
-  * @brief  Tap/Double Tap generator source register.[get]
+  * @brief  Interrupt generator 1 source register.[get]
   *
   * @param  ctx      read / write interface definitions
-  * @param  val      registers CLICK_SRC
+  * @param  val      Registers INT1_SRC
   * @retval          interface status (MANDATORY: return 0 -> no Error)
   *
   */
-int32_t lis3de_tap_source_get(const stmdev_ctx_t *ctx,
-                              lis3de_click_src_t *val)
+int32_t lis3de_int1_gen_source_get(const stmdev_ctx_t *ctx,
+                                   lis3de_ig1_source_t *val)
 {
   int32_t ret;
 
-  ret = lis3de_read_reg(ctx, LIS3DE_CLICK_SRC, (uint8_t *) val, 1);
+  ret = lis3de_read_reg(ctx, LIS3DE_IG1_SOURCE, (uint8_t *) val, 1);
 
   return ret;
 }
 /**
-  * @brief  User-defined threshold value for Tap/Double Tap event.[set]
-  *         1 LSB = full scale/128
+  * @brief  User-defined threshold value for xl interrupt event on
+  *         generator 1.[set]
+  *         LSb = 16mg@2g / 32mg@4g / 62mg@8g / 186mg@16g
   *
   * @param  ctx      read / write interface definitions
-  * @param  val      change the values of ths in reg CLICK_THS
+  * @param  val      change the values of ths in reg INT1_THS
   * @retval          interface status (MANDATORY: return 0 -> no Error)
   *
   */
-int32_t lis3de_tap_threshold_set(const stmdev_ctx_t *ctx, uint8_t val)
+int32_t lis3de_int1_gen_threshold_set(const stmdev_ctx_t *ctx, uint8_t val)
 {
-  lis3de_click_ths_t click_ths;
+  lis3de_ig1_ths_t int1_ths;
   int32_t ret;
 
-  ret = lis3de_read_reg(ctx, LIS3DE_CLICK_THS, (uint8_t *)&click_ths, 1);
+  lis3de_lock(ctx);
+
+  ret = lis3de_read_reg(ctx, LIS3DE_IG1_THS, (uint8_t *)&int1_ths, 1);
 
   if (ret == 0)
   {
-    click_ths.ths = val;
-    ret = lis3de_write_reg(ctx, LIS3DE_CLICK_THS, (uint8_t *)&click_ths, 1);
+    int1_ths.ths = val;
+    ret = lis3de_write_reg(ctx, LIS3DE_IG1_THS, (uint8_t *)&int1_ths, 1);
   }
 
+  lis3de_unlock(ctx);
+
   return ret;
 }
 
 /**
-  * @brief  User-defined threshold value for Tap/Double Tap event.[get]
-  *         1 LSB = full scale/128
+  * @brief  User-defined threshold value for xl interrupt event on
+  *         generator 1.[get]
+  *         LSb = 16mg@2g / 32mg@4g / 62mg@8g / 186mg@16g
   *
   * @param  ctx      read / write interface definitions
-  * @param  val      change the values of ths in reg CLICK_THS
+  * @param  val      change the values of ths in reg INT1_THS
   * @retval          interface status (MANDATORY: return 0 -> no Error)
   *
   */
-int32_t lis3de_tap_threshold_get(const stmdev_ctx_t *ctx, uint8_t *val)
+int32_t lis3de_int1_gen_threshold_get(const stmdev_ctx_t *ctx, uint8_t *val)
 {
-  lis3de_click_ths_t click_ths;
+  lis3de_ig1_ths_t int1_ths;
   int32_t ret;
 
-  ret = lis3de_read_reg(ctx, LIS3DE_CLICK_THS, (uint8_t *)&click_ths, 1);
-  *val = (uint8_t)click_ths.ths;
+  ret = lis3de_read_reg(ctx, LIS3DE_IG1_THS, (uint8_t *)&int1_ths, 1);
+  *val = (uint8_t)int1_ths.ths;
 
   return ret;
 }
 
 /**
-  * @brief   If the LIR_Click bit is not set, the interrupt is kept high
-  *          for the duration of the latency window.
-  *          If the LIR_Click bit is set, the interrupt is kept high until the
-  *          CLICK_SRC(39h) register is read.[set]
+  * @brief  The minimum duration (LSb = 1/ODR) of the Interrupt 1 event to be
+  *         recognized.[set]
   *
   * @param  ctx      read / write interface definitions
-  * @param  val      change the values of lir in reg CLICK_THS
+  * @param  val      change the values of d in reg INT1_DURATION
   * @retval          interface status (MANDATORY: return 0 -> no Error)
   *
   */
-int32_t lis3de_tap_notification_mode_set(const stmdev_ctx_t *ctx,
-                                         lis3de_lir_t val)
+int32_t lis3de_int1_gen_duration_set(const stmdev_ctx_t *ctx, uint8_t val)
 {
-  lis3de_click_ths_t click_ths;
+  lis3de_ig1_duration_t int1_duration;
   int32_t ret;
 
-  ret = lis3de_read_reg(ctx, LIS3DE_CLICK_THS, (uint8_t *)&click_ths, 1);
+  lis3de_lock(ctx);
+
+  ret = lis3de_read_reg(ctx, LIS3DE_IG1_DURATION,
+                        (uint8_t *)&int1_duration, 1);
 
   if (ret == 0)
   {
-    click_ths.lir = (uint8_t)val;
-    ret = lis3de_write_reg(ctx, LIS3DE_CLICK_THS, (uint8_t *)&click_ths, 1);
+    int1_duration.d = val;
+    ret = lis3de_write_reg(ctx, LIS3DE_IG1_DURATION,
+                           (uint8_t *)&int1_duration, 1);
   }
 
+  lis3de_unlock(ctx);
+
   return ret;
 }
 
 /**
-  * @brief   If the LIR_Click bit is not set, the interrupt is kept high
-  *          for the duration of the latency window.
-  *          If the LIR_Click bit is set, the interrupt is kept high until the
-  *          CLICK_SRC(39h) register is read.[get]
+  * @brief  The minimum duration (LSb = 1/ODR) of the Interrupt 1 event to be
+  *         recognized.[get]
   *
   * @param  ctx      read / write interface definitions
-  * @param  val      Get the values of lir in reg CLICK_THS
+  * @param  val      change the values of d in reg INT1_DURATION
   * @retval          interface status (MANDATORY: return 0 -> no Error)
   *
   */
-int32_t lis3de_tap_notification_mode_get(const stmdev_ctx_t *ctx,
-                                         lis3de_lir_t *val)
+int32_t lis3de_int1_gen_duration_get(const stmdev_ctx_t *ctx, uint8_t *val)
 {
-  lis3de_click_ths_t click_ths;
+  lis3de_ig1_duration_t int1_duration;
   int32_t ret;
 
-  ret = lis3de_read_reg(ctx, LIS3DE_CLICK_THS, (uint8_t *)&click_ths, 1);
+  ret = lis3de_read_reg(ctx, LIS3DE_IG1_DURATION,
+                        (uint8_t *)&int1_duration, 1);
+  *val = (uint8_t)int1_duration.d;
 
-  switch (click_ths.lir)
-  {
-    case LIS3DE_TAP_PULSED:
-      *val = LIS3DE_TAP_PULSED;
-      break;
+  return ret;
+}
 
-    case LIS3DE_TAP_LATCHED:
-      *val = LIS3DE_TAP_LATCHED;
-      break;
+/**
+  * @}
+  *
+  */
 
-    default:
-      *val = LIS3DE_TAP_PULSED;
-      break;
+/**
+  * @defgroup   LIS3DE_Interrupts_generator_2
+  * @brief      This section group all the functions that manage the second
+  *             interrupts generator
+  * @{
+  *
+  */
+
+/**
+  * @brief  Interrupt generator 2 configuration register.[set]
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      registers IG2_CFG
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lis3de_int2_gen_conf_set(const stmdev_ctx_t *ctx,
+                                 lis3de_ig2_cfg_t *val)
+{
+  int32_t ret;
+
+  ret = lis3de_write_reg(ctx, LIS3DE_IG2_CFG, (uint8_t *) val, 1);
+
+  return ret;
+}
+
+/**
+  * @brief  Interrupt generator 2 configuration register.[get]
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      registers IG2_CFG
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lis3de_int2_gen_conf_get(const stmdev_ctx_t *ctx,
+                                 lis3de_ig2_cfg_t *val)
+{
+  int32_t ret;
+
+  ret = lis3de_read_reg(ctx, LIS3DE_IG2_CFG, (uint8_t *) val, 1);
+
+  return ret;
+}
+/**
+  * @brief  Interrupt generator 2 source register.[get]
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      registers INT2_SRC
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lis3de_int2_gen_source_get(const stmdev_ctx_t *ctx,
+                                   lis3de_ig2_source_t *val)
+{
+  int32_t ret;
+
+  ret = lis3de_read_reg(ctx, LIS3DE_IG2_SOURCE, (uint8_t *) val, 1);
+
+  return ret;
+}
+/**
+  * @brief   User-defined threshold value for xl interrupt event on
+  *          generator 2.[set]
+  *          LSb = 16mg@2g / 32mg@4g / 62mg@8g / 186mg@16g
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      change the values of ths in reg INT2_THS
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lis3de_int2_gen_threshold_set(const stmdev_ctx_t *ctx, uint8_t val)
+{
+  lis3de_ig2_ths_t int2_ths;
+  int32_t ret;
+
+  lis3de_lock(ctx);
+
+  ret = lis3de_read_reg(ctx, LIS3DE_IG2_THS, (uint8_t *)&int2_ths, 1);
+
+  if (ret == 0)
+  {
+    int2_ths.ths = val;
+    ret = lis3de_write_reg(ctx, LIS3DE_IG2_THS, (uint8_t *)&int2_ths, 1);
   }
 
+  lis3de_unlock(ctx);
+
   return ret;
 }
 
 /**
-  * @brief  The maximum time (1 LSB = 1/ODR) interval that can elapse
-  *         between the start of the click-detection procedure and when the
-  *         acceleration falls back below the threshold.[set]
+  * @brief  User-defined threshold value for xl interrupt event on
+  *         generator 2.[get]
+  *         LSb = 16mg@2g / 32mg@4g / 62mg@8g / 186mg@16g
   *
   * @param  ctx      read / write interface definitions
-  * @param  val      change the values of tli in reg TIME_LIMIT
+  * @param  val      change the values of ths in reg INT2_THS
   * @retval          interface status (MANDATORY: return 0 -> no Error)
   *
   */
-int32_t lis3de_shock_dur_set(const stmdev_ctx_t *ctx, uint8_t val)
+int32_t lis3de_int2_gen_threshold_get(const stmdev_ctx_t *ctx, uint8_t *val)
 {
-  lis3de_time_limit_t time_limit;
+  lis3de_ig2_ths_t int2_ths;
   int32_t ret;
 
-  ret = lis3de_read_reg(ctx, LIS3DE_TIME_LIMIT, (uint8_t *)&time_limit, 1);
+  ret = lis3de_read_reg(ctx, LIS3DE_IG2_THS, (uint8_t *)&int2_ths, 1);
+  *val = (uint8_t)int2_ths.ths;
+
+  return ret;
+}
+
+/**
+  * @brief  The minimum duration (LSb = 1/ODR) of the Interrupt 1 event to be
+  *         recognized .[set]
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      change the values of d in reg INT2_DURATION
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lis3de_int2_gen_duration_set(const stmdev_ctx_t *ctx, uint8_t val)
+{
+  lis3de_ig2_duration_t int2_duration;
+  int32_t ret;
+
+  lis3de_lock(ctx);
+
+  ret = lis3de_read_reg(ctx, LIS3DE_IG2_DURATION,
+                        (uint8_t *)&int2_duration, 1);
+
+  if (ret == 0)
+  {
+    int2_duration.d = val;
+    ret = lis3de_write_reg(ctx, LIS3DE_IG2_DURATION,
+                           (uint8_t *)&int2_duration, 1);
+  }
+
+  lis3de_unlock(ctx);
+
+  return ret;
+}
+
+/**
+  * @brief  The minimum duration (LSb = 1/ODR) of the Interrupt 1 event to be
+  *         recognized.[get]
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      change the values of d in reg INT2_DURATION
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lis3de_int2_gen_duration_get(const stmdev_ctx_t *ctx, uint8_t *val)
+{
+  lis3de_ig2_duration_t int2_duration;
+  int32_t ret;
+
+  ret = lis3de_read_reg(ctx, LIS3DE_IG2_DURATION,
+                        (uint8_t *)&int2_duration, 1);
+  *val = (uint8_t)int2_duration.d;
+
+  return ret;
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup  LIS3DE_Interrupt_pins
+  * @brief     This section group all the functions that manage interrupt pins
+  * @{
+  *
+  */
+
+/**
+  * @brief  High-pass filter on interrupts/tap generator.[set]
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      change the values of hp in reg CTRL_REG2
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lis3de_high_pass_int_conf_set(const stmdev_ctx_t *ctx,
+                                      lis3de_hp_t val)
+{
+  lis3de_ctrl_reg2_t ctrl_reg2;
+  int32_t ret;
+
+  lis3de_lock(ctx);
+
+  ret = lis3de_read_reg(ctx, LIS3DE_CTRL_REG2, (uint8_t *)&ctrl_reg2, 1);
+
+  if (ret == 0)
+  {
+    ctrl_reg2.hp = (uint8_t)val;
+    ret = lis3de_write_reg(ctx, LIS3DE_CTRL_REG2, (uint8_t *)&ctrl_reg2, 1);
+  }
+
+  lis3de_unlock(ctx);
+
+  return ret;
+}
+
+/**
+  * @brief  High-pass filter on interrupts/tap generator.[get]
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      Get the values of hp in reg CTRL_REG2
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lis3de_high_pass_int_conf_get(const stmdev_ctx_t *ctx,
+                                      lis3de_hp_t *val)
+{
+  lis3de_ctrl_reg2_t ctrl_reg2;
+  int32_t ret;
+
+  ret = lis3de_read_reg(ctx, LIS3DE_CTRL_REG2, (uint8_t *)&ctrl_reg2, 1);
+
+  switch (ctrl_reg2.hp)
+  {
+    case LIS3DE_DISC_FROM_INT_GENERATOR:
+      *val = LIS3DE_DISC_FROM_INT_GENERATOR;
+      break;
+
+    case LIS3DE_ON_INT1_GEN:
+      *val = LIS3DE_ON_INT1_GEN;
+      break;
+
+    case LIS3DE_ON_INT2_GEN:
+      *val = LIS3DE_ON_INT2_GEN;
+      break;
+
+    case LIS3DE_ON_TAP_GEN:
+      *val = LIS3DE_ON_TAP_GEN;
+      break;
+
+    case LIS3DE_ON_INT1_INT2_GEN:
+      *val = LIS3DE_ON_INT1_INT2_GEN;
+      break;
+
+    case LIS3DE_ON_INT1_TAP_GEN:
+      *val = LIS3DE_ON_INT1_TAP_GEN;
+      break;
+
+    case LIS3DE_ON_INT2_TAP_GEN:
+      *val = LIS3DE_ON_INT2_TAP_GEN;
+      break;
+
+    case LIS3DE_ON_INT1_INT2_TAP_GEN:
+      *val = LIS3DE_ON_INT1_INT2_TAP_GEN;
+      break;
+
+    default:
+      *val = LIS3DE_DISC_FROM_INT_GENERATOR;
+      break;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Int1 pin routing configuration register.[set]
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      registers CTRL_REG3
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lis3de_pin_int1_config_set(const stmdev_ctx_t *ctx,
+                                   lis3de_ctrl_reg3_t *val)
+{
+  int32_t ret;
+
+  ret = lis3de_write_reg(ctx, LIS3DE_CTRL_REG3, (uint8_t *) val, 1);
+
+  return ret;
+}
+
+/**
+  * @brief  Int1 pin routing configuration register.[get]
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      registers CTRL_REG3
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lis3de_pin_int1_config_get(const stmdev_ctx_t *ctx,
+                                   lis3de_ctrl_reg3_t *val)
+{
+  int32_t ret;
+
+  ret = lis3de_read_reg(ctx, LIS3DE_CTRL_REG3, (uint8_t *) val, 1);
+
+  return ret;
+}
+/**
+  * @brief  int2_pin_detect_4d: [set]  4D enable: 4D detection is enabled
+  *                                    on INT2 pin when 6D bit on
+  *                                    IG2_CFG (34h) is set to 1.
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      change the values of d4d_ig2 in reg CTRL_REG5
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lis3de_int2_pin_detect_4d_set(const stmdev_ctx_t *ctx, uint8_t val)
+{
+  lis3de_ctrl_reg5_t ctrl_reg5;
+  int32_t ret;
+
+  lis3de_lock(ctx);
+
+  ret = lis3de_read_reg(ctx, LIS3DE_CTRL_REG5, (uint8_t *)&ctrl_reg5, 1);
+
+  if (ret == 0)
+  {
+    ctrl_reg5.d4d_ig2 = val;
+    ret = lis3de_write_reg(ctx, LIS3DE_CTRL_REG5, (uint8_t *)&ctrl_reg5, 1);
+  }
+
+  lis3de_unlock(ctx);
+
+  return ret;
+}
+
+/**
+  * @brief  4D enable: 4D detection is enabled on INT2 pin when 6D bit on
+  *         IG2_CFG (34h) is set to 1.[get]
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      change the values of d4d_ig2 in reg CTRL_REG5
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lis3de_int2_pin_detect_4d_get(const stmdev_ctx_t *ctx, uint8_t *val)
+{
+  lis3de_ctrl_reg5_t ctrl_reg5;
+  int32_t ret;
+
+  ret = lis3de_read_reg(ctx, LIS3DE_CTRL_REG5, (uint8_t *)&ctrl_reg5, 1);
+  *val = (uint8_t)ctrl_reg5.d4d_ig2;
+
+  return ret;
+}
+
+/**
+  * @brief   Latch interrupt request on INT2_SRC (35h) register, with
+  *          INT2_SRC (35h) register cleared by reading INT2_SRC(35h)
+  *          itself.[set]
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      change the values of lir_ig2 in reg CTRL_REG5
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lis3de_int2_pin_notification_mode_set(const stmdev_ctx_t *ctx,
+                                              lis3de_lir_int2_t val)
+{
+  lis3de_ctrl_reg5_t ctrl_reg5;
+  int32_t ret;
+
+  lis3de_lock(ctx);
+
+  ret = lis3de_read_reg(ctx, LIS3DE_CTRL_REG5, (uint8_t *)&ctrl_reg5, 1);
+
+  if (ret == 0)
+  {
+    ctrl_reg5.lir_ig2 = (uint8_t)val;
+    ret = lis3de_write_reg(ctx, LIS3DE_CTRL_REG5, (uint8_t *)&ctrl_reg5, 1);
+  }
+
+  lis3de_unlock(ctx);
+
+  return ret;
+}
+
+/**
+  * @brief   Latch interrupt request on INT2_SRC (35h) register, with
+  *          INT2_SRC (35h) register cleared by reading INT2_SRC(35h)
+  *          itself.[get]
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      Get the values of lir_ig2 in reg CTRL_REG5
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lis3de_int2_pin_notification_mode_get(const stmdev_ctx_t *ctx,
+                                              lis3de_lir_int2_t *val)
+{
+  lis3de_ctrl_reg5_t ctrl_reg5;
+  int32_t ret;
+
+  ret = lis3de_read_reg(ctx, LIS3DE_CTRL_REG5, (uint8_t *)&ctrl_reg5, 1);
+
+  switch (ctrl_reg5.lir_ig2)
+  {
+    case LIS3DE_INT2_PULSED:
+      *val = LIS3DE_INT2_PULSED;
+      break;
+
+    case LIS3DE_INT2_LATCHED:
+      *val = LIS3DE_INT2_LATCHED;
+      break;
+
+    default:
+      *val = LIS3DE_INT2_PULSED;
+      break;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  4D enable: 4D detection is enabled on INT1 pin when 6D bit
+  *                    on INT1_CFG(30h) is set to 1.[set]
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      change the values of d4d_ig1 in reg CTRL_REG5
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lis3de_int1_pin_detect_4d_set(const stmdev_ctx_t *ctx, uint8_t val)
+{
+  lis3de_ctrl_reg5_t ctrl_reg5;
+  int32_t ret;
+
+  lis3de_lock(ctx);
+
+  ret = lis3de_read_reg(ctx, LIS3DE_CTRL_REG5, (uint8_t *)&ctrl_reg5, 1);
+
+  if (ret == 0)
+  {
+    ctrl_reg5.d4d_ig1 = val;
+    ret = lis3de_write_reg(ctx, LIS3DE_CTRL_REG5, (uint8_t *)&ctrl_reg5, 1);
+  }
+
+  lis3de_unlock(ctx);
+
+  return ret;
+}
+
+/**
+  * @brief  4D enable: 4D detection is enabled on INT1 pin when 6D bit on
+  *         INT1_CFG(30h) is set to 1.[get]
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      change the values of d4d_ig1 in reg CTRL_REG5
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lis3de_int1_pin_detect_4d_get(const stmdev_ctx_t *ctx, uint8_t *val)
+{
+  lis3de_ctrl_reg5_t ctrl_reg5;
+  int32_t ret;
+
+  ret = lis3de_read_reg(ctx, LIS3DE_CTRL_REG5, (uint8_t *)&ctrl_reg5, 1);
+  *val = (uint8_t)ctrl_reg5.d4d_ig1;
+
+  return ret;
+}
+
+/**
+  * @brief   Latch interrupt request on INT1_SRC (31h), with INT1_SRC(31h)
+  *          register cleared by reading INT1_SRC (31h) itself.[set]
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      change the values of lir_ig1 in reg CTRL_REG5
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lis3de_int1_pin_notification_mode_set(const stmdev_ctx_t *ctx,
+                                              lis3de_lir_int1_t val)
+{
+  lis3de_ctrl_reg5_t ctrl_reg5;
+  int32_t ret;
+
+  lis3de_lock(ctx);
+
+  ret = lis3de_read_reg(ctx, LIS3DE_CTRL_REG5, (uint8_t *)&ctrl_reg5, 1);
+
+  if (ret == 0)
+  {
+    ctrl_reg5.lir_ig1 = (uint8_t)val;
+    ret = lis3de_write_reg(ctx, LIS3DE_CTRL_REG5, (uint8_t *)&ctrl_reg5, 1);
+  }
+
+  lis3de_unlock(ctx);
+
+  return ret;
+}
+
+/**
+  * @brief   Latch interrupt request on INT1_SRC (31h), with INT1_SRC(31h)
+  *          register cleared by reading INT1_SRC (31h) itself.[get]
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      Get the values of lir_ig1 in reg CTRL_REG5
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lis3de_int1_pin_notification_mode_get(const stmdev_ctx_t *ctx,
+                                              lis3de_lir_int1_t *val)
+{
+  lis3de_ctrl_reg5_t ctrl_reg5;
+  int32_t ret;
+
+  ret = lis3de_read_reg(ctx, LIS3DE_CTRL_REG5, (uint8_t *)&ctrl_reg5, 1);
+
+  switch (ctrl_reg5.lir_ig1)
+  {
+    case LIS3DE_INT1_PULSED:
+      *val = LIS3DE_INT1_PULSED;
+      break;
+
+    case LIS3DE_INT1_LATCHED:
+      *val = LIS3DE_INT1_LATCHED;
+      break;
+
+    default:
+      *val = LIS3DE_INT1_PULSED;
+      break;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Int2 pin routing configuration register.[set]
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      registers CTRL_REG6
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lis3de_pin_int2_config_set(const stmdev_ctx_t *ctx,
+                                   lis3de_ctrl_reg6_t *val)
+{
+  int32_t ret;
+
+  ret = lis3de_write_reg(ctx, LIS3DE_CTRL_REG6, (uint8_t *) val, 1);
+
+  return ret;
+}
+
+/**
+  * @brief  Int2 pin routing configuration register.[get]
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      registers CTRL_REG6
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lis3de_pin_int2_config_get(const stmdev_ctx_t *ctx,
+                                   lis3de_ctrl_reg6_t *val)
+{
+  int32_t ret;
+
+  ret = lis3de_read_reg(ctx, LIS3DE_CTRL_REG6, (uint8_t *) val, 1);
+
+  return ret;
+}
+
+/**
+  * @brief  Snapshot of the interrupt causes. Only the source registers
+  *         of the causes routed on INT1 / INT2 (CTRL_REG3, CTRL_REG6)
+  *         are read, so no unrouted latched source is cleared; adjacent
+  *         ones are read in the same burst.
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      source registers and LIS3DE_IRQ_* causes
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lis3de_irq_sources_get(const stmdev_ctx_t *ctx,
+                               lis3de_irq_snapshot_t *val)
+{
+  /* sorted by address, FIFO_SRC (2Fh) .. CLICK_SRC (39h) */
+  static const uint8_t src_addr[4] =
+  {
+    LIS3DE_FIFO_SRC_REG, LIS3DE_IG1_SOURCE,
+    LIS3DE_IG2_SOURCE, LIS3DE_CLICK_SRC,
+  };
+  static const uint8_t src_irq[4] =
+  {
+    LIS3DE_IRQ_FIFO_WTM | LIS3DE_IRQ_FIFO_OVR, LIS3DE_IRQ_IA1,
+    LIS3DE_IRQ_IA2, LIS3DE_IRQ_CLICK,
+  };
+  lis3de_ctrl_reg3_t ctrl_reg3;
+  lis3de_ctrl_reg6_t ctrl_reg6;
+  uint8_t inc = lis3de_multi_rw(ctx);
+  uint8_t raw[LIS3DE_CLICK_SRC - LIS3DE_FIFO_SRC_REG + 1U];
+  uint8_t ctrl[4];
+  uint8_t first;
+  uint8_t last;
+  uint8_t addr;
+  int32_t ret;
+
+  lis3de_lock(ctx);
+
+  if (inc != 0U)
+  {
+    /* CTRL_REG3 .. CTRL_REG6, answered by the shadow cache when valid */
+    ret = lis3de_read_reg(ctx, (uint8_t)(LIS3DE_CTRL_REG3 | inc), ctrl, 4);
+  }
+
+  else
+  {
+    ret = lis3de_read_reg(ctx, LIS3DE_CTRL_REG3, &ctrl[0], 1);
+
+    if (ret == 0)
+    {
+      ret = lis3de_read_reg(ctx, LIS3DE_CTRL_REG6, &ctrl[3], 1);
+    }
+  }
+
+  *(uint8_t *)&ctrl_reg3 = ctrl[0];
+  *(uint8_t *)&ctrl_reg6 = ctrl[3];
+  val->routed = 0U;
+  val->active = 0U;
+
+  if ((ctrl_reg3.int1_wtm | ctrl_reg3.int1_overrun) != 0U)
+  {
+    val->routed |= LIS3DE_IRQ_FIFO_WTM | LIS3DE_IRQ_FIFO_OVR;
+  }
+
+  if ((ctrl_reg3.int1_ig1 | ctrl_reg6.int2_ig1) != 0U)
+  {
+    val->routed |= LIS3DE_IRQ_IA1;
+  }
+
+  if ((ctrl_reg3.int1_ig2 | ctrl_reg6.int2_ig2) != 0U)
+  {
+    val->routed |= LIS3DE_IRQ_IA2;
+  }
+
+  if ((ctrl_reg3.int1_click | ctrl_reg6.int2_click) != 0U)
+  {
+    val->routed |= LIS3DE_IRQ_CLICK;
+  }
+
+  if ((ctrl_reg3.int1_drdy1 | ctrl_reg3.int1_drdy2) != 0U)
+  {
+    val->routed |= LIS3DE_IRQ_DRDY;
+  }
+
+  for (first = 0U; first < sizeof(raw); first++)
+  {
+    raw[first] = 0U;
+  }
+
+  /* one burst per run of routed sources, the registers in between
+   * (configuration, threshold, duration) are read without side effects */
+  first = 0U;
+
+  while ((first < 4U) && (ret == 0))
+  {
+    if ((val->routed & src_irq[first]) == 0U)
+    {
+      first++;
+    }
+
+    else
+    {
+      last = first;
+
+      while ((inc != 0U) && (last < 3U) &&
+             ((val->routed & src_irq[last + 1U]) != 0U))
+      {
+        last++;
+      }
+
+      addr = (first == last) ? src_addr[first] :
+             (uint8_t)(src_addr[first] | inc);
+      ret = lis3de_read_reg(ctx, addr,
+                            &raw[src_addr[first] - LIS3DE_FIFO_SRC_REG],
+                            (uint16_t)src_addr[last] - src_addr[first] + 1U);
+      first = last + 1U;
+    }
+  }
+
+  *(uint8_t *)&val->status_reg = 0U;
+
+  if ((ret == 0) && ((val->routed & LIS3DE_IRQ_DRDY) != 0U))
+  {
+    ret = lis3de_read_reg(ctx, LIS3DE_STATUS_REG,
+                          (uint8_t *)&val->status_reg, 1);
+  }
+
+  lis3de_unlock(ctx);
+
+  *(uint8_t *)&val->fifo_src_reg = raw[0];
+  *(uint8_t *)&val->ig1_source =
+    raw[LIS3DE_IG1_SOURCE - LIS3DE_FIFO_SRC_REG];
+  *(uint8_t *)&val->ig2_source =
+    raw[LIS3DE_IG2_SOURCE - LIS3DE_FIFO_SRC_REG];
+  *(uint8_t *)&val->click_src =
+    raw[LIS3DE_CLICK_SRC - LIS3DE_FIFO_SRC_REG];
+
+  if (val->fifo_src_reg.wtm == PROPERTY_ENABLE)
+  {
+    val->active |= LIS3DE_IRQ_FIFO_WTM;
+  }
+
+  if (val->fifo_src_reg.ovrn_fifo == PROPERTY_ENABLE)
+  {
+    val->active |= LIS3DE_IRQ_FIFO_OVR;
+  }
+
+  if (val->ig1_source.ia == PROPERTY_ENABLE)
+  {
+    val->active |= LIS3DE_IRQ_IA1;
+  }
+
+  if (val->ig2_source.ia == PROPERTY_ENABLE)
+  {
+    val->active |= LIS3DE_IRQ_IA2;
+  }
+
+  if (val->click_src.ia == PROPERTY_ENABLE)
+  {
+    val->active |= LIS3DE_IRQ_CLICK;
+  }
+
+  if (val->status_reg.zyxda == PROPERTY_ENABLE)
+  {
+    val->active |= LIS3DE_IRQ_DRDY;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Event handlers table of the context
+  *
+  * @param  ctx   read / write interface definitions(ptr)
+  * @retval       LIS3DE_EVT_NUM handlers, NULL if not used
+  *
+  */
+static lis3de_evt_slot_t *lis3de_events(const stmdev_ctx_t *ctx)
+{
+  const lis3de_priv_t *priv;
+  lis3de_evt_slot_t *events = NULL;
+
+  if ((ctx != NULL) && (ctx->priv_data != NULL))
+  {
+    priv = (const lis3de_priv_t *)ctx->priv_data;
+    events = priv->events;
+  }
+
+  return events;
+}
+
+/**
+  * @brief  Call the handler of an event, if registered
+  *
+  * @param  events   handlers table
+  * @param  evt      pre-decoded event
+  *
+  */
+static void lis3de_evt_emit(const lis3de_evt_slot_t *events,
+                            const lis3de_event_t *evt)
+{
+  if (events[evt->id].cb != NULL)
+  {
+    events[evt->id].cb(evt, events[evt->id].user);
+  }
+}
+
+/**
+  * @brief  Fill a pre-decoded event
+  *
+  * @param  evt      event to fill
+  * @param  id       event identifier
+  * @param  src      raw source register
+  * @param  axes     axes bits of the source register
+  *
+  */
+static void lis3de_evt_fill(lis3de_event_t *evt, lis3de_evt_id_t id,
+                            uint8_t src, uint8_t axes)
+{
+  evt->id = id;
+  evt->src = src;
+  evt->axes = axes;
+  evt->sign = 0U;
+  evt->level = 0U;
+}
+
+/**
+  * @brief  Clear an event table before it is set in
+  *         lis3de_priv_t.events: every slot without a handler.
+  *
+  * @param  events   LIS3DE_EVT_NUM slots
+  *
+  */
+void lis3de_events_init(lis3de_evt_slot_t *events)
+{
+  uint8_t i;
+
+  for (i = 0U; i < (uint8_t)LIS3DE_EVT_NUM; i++)
+  {
+    events[i].cb = NULL;
+    events[i].user = NULL;
+  }
+}
+
+/**
+  * @brief  Register the handler of an event in the table referenced
+  *         by lis3de_priv_t.events; NULL cb removes it.
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  id       event identifier
+  * @param  cb       handler, called by lis3de_irq_dispatch
+  * @param  user     handler argument
+  * @retval          0 -> no Error, -1 -> no table or invalid event
+  *
+  */
+int32_t lis3de_on_event(const stmdev_ctx_t *ctx, lis3de_evt_id_t id,
+                        lis3de_evt_ptr cb, void *user)
+{
+  lis3de_evt_slot_t *events = lis3de_events(ctx);
+  int32_t ret = 0;
+
+  if ((events == NULL) || ((uint32_t)id >= (uint32_t)LIS3DE_EVT_NUM))
+  {
+    ret = -1;
+  }
+
+  else
+  {
+    events[id].cb = cb;
+    events[id].user = user;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  To be called from the INT1 / INT2 handler: takes one
+  *         lis3de_irq_sources_get snapshot and calls the handler of
+  *         every active event. A generator set in 6D mode reports
+  *         LIS3DE_EVT_6D instead of LIS3DE_EVT_IA1 / LIS3DE_EVT_IA2;
+  *         its configuration is read (or taken from the shadow cache)
+  *         only when it fired.
+  *
+  * @param  ctx      read / write interface definitions
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lis3de_irq_dispatch(const stmdev_ctx_t *ctx)
+{
+  lis3de_evt_slot_t *events = lis3de_events(ctx);
+  lis3de_irq_snapshot_t snap;
+  lis3de_ig1_cfg_t ig1_cfg;
+  lis3de_ig2_cfg_t ig2_cfg;
+  lis3de_event_t evt;
+  uint8_t src;
+  int32_t ret;
+
+  ret = lis3de_irq_sources_get(ctx, &snap);
+
+  if ((ret == 0) && (events != NULL))
+  {
+    if ((snap.active & LIS3DE_IRQ_IA1) != 0U)
+    {
+      src = *(uint8_t *)&snap.ig1_source;
+      ret = lis3de_read_reg(ctx, LIS3DE_IG1_CFG, (uint8_t *)&ig1_cfg, 1);
+
+      if (ret == 0)
+      {
+        lis3de_evt_fill(&evt, (ig1_cfg._6d == PROPERTY_ENABLE) ?
+                        LIS3DE_EVT_6D : LIS3DE_EVT_IA1, src, src & 0x3FU);
+        lis3de_evt_emit(events, &evt);
+      }
+    }
+
+    if ((ret == 0) && ((snap.active & LIS3DE_IRQ_IA2) != 0U))
+    {
+      src = *(uint8_t *)&snap.ig2_source;
+      ret = lis3de_read_reg(ctx, LIS3DE_IG2_CFG, (uint8_t *)&ig2_cfg, 1);
+
+      if (ret == 0)
+      {
+        lis3de_evt_fill(&evt, (ig2_cfg._6d == PROPERTY_ENABLE) ?
+                        LIS3DE_EVT_6D : LIS3DE_EVT_IA2, src, src & 0x3FU);
+        lis3de_evt_emit(events, &evt);
+      }
+    }
+
+    if ((snap.active & LIS3DE_IRQ_CLICK) != 0U)
+    {
+      src = *(uint8_t *)&snap.click_src;
+      lis3de_evt_fill(&evt, (snap.click_src.dclick == PROPERTY_ENABLE) ?
+                      LIS3DE_EVT_DOUBLE_TAP : LIS3DE_EVT_SINGLE_TAP,
+                      src, src & 0x07U);
+      evt.sign = snap.click_src.sign;
+      lis3de_evt_emit(events, &evt);
+    }
+
+    if ((snap.active & LIS3DE_IRQ_DRDY) != 0U)
+    {
+      lis3de_evt_fill(&evt, LIS3DE_EVT_DRDY,
+                      *(uint8_t *)&snap.status_reg, 0U);
+      lis3de_evt_emit(events, &evt);
+    }
+
+    src = *(uint8_t *)&snap.fifo_src_reg;
+
+    if ((snap.active & LIS3DE_IRQ_FIFO_OVR) != 0U)
+    {
+      lis3de_evt_fill(&evt, LIS3DE_EVT_FIFO_OVR, src, 0U);
+      evt.level = (uint8_t)LIS3DE_FIFO_SIZE;
+      lis3de_evt_emit(events, &evt);
+    }
+
+    else if ((snap.active & LIS3DE_IRQ_FIFO_WTM) != 0U)
+    {
+      lis3de_evt_fill(&evt, LIS3DE_EVT_FIFO_WTM, src, 0U);
+      evt.level = snap.fifo_src_reg.fss;
+      lis3de_evt_emit(events, &evt);
+    }
+
+    else
+    {
+      /* no FIFO event */
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  To be called on both edges of INT2 when activity /
+  *         inactivity is routed on it (CTRL_REG6 int2_act): the state
+  *         has no source register, only the pin tells it.
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  asserted INT2 in its active level (see h_lactive) -> sleep
+  * @retval          0 -> no Error, -1 -> no handlers table
+  *
+  */
+int32_t lis3de_act_dispatch(const stmdev_ctx_t *ctx, uint8_t asserted)
+{
+  lis3de_evt_slot_t *events = lis3de_events(ctx);
+  lis3de_event_t evt;
+  int32_t ret = 0;
+
+  if (events == NULL)
+  {
+    ret = -1;
+  }
+
+  else
+  {
+    lis3de_evt_fill(&evt, (asserted != 0U) ? LIS3DE_EVT_SLEEP :
+                    LIS3DE_EVT_WAKE, 0U, 0U);
+    lis3de_evt_emit(events, &evt);
+  }
+
+  return ret;
+}
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup  LIS3DE_Fifo
+  * @brief     This section group all the functions concerning the fifo usage
+  * @{
+  *
+  */
+
+/**
+  * @brief  FIFO enable.[set]
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      change the values of fifo_en in reg CTRL_REG5
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lis3de_fifo_set(const stmdev_ctx_t *ctx, uint8_t val)
+{
+  lis3de_ctrl_reg5_t ctrl_reg5;
+  int32_t ret;
+
+  lis3de_lock(ctx);
+
+  ret = lis3de_read_reg(ctx, LIS3DE_CTRL_REG5, (uint8_t *)&ctrl_reg5, 1);
+
+  if (ret == 0)
+  {
+    ctrl_reg5.fifo_en = val;
+    ret = lis3de_write_reg(ctx, LIS3DE_CTRL_REG5, (uint8_t *)&ctrl_reg5, 1);
+  }
+
+  lis3de_unlock(ctx);
+
+  return ret;
+}
+
+/**
+  * @brief  FIFO enable.[get]
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      change the values of fifo_en in reg CTRL_REG5
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lis3de_fifo_get(const stmdev_ctx_t *ctx, uint8_t *val)
+{
+  lis3de_ctrl_reg5_t ctrl_reg5;
+  int32_t ret;
+
+  ret = lis3de_read_reg(ctx, LIS3DE_CTRL_REG5, (uint8_t *)&ctrl_reg5, 1);
+  *val = (uint8_t)ctrl_reg5.fifo_en;
+
+  return ret;
+}
+
+/**
+  * @brief  FIFO watermark level selection.[set]
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      change the values of fth in reg FIFO_CTRL_REG
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lis3de_fifo_watermark_set(const stmdev_ctx_t *ctx, uint8_t val)
+{
+  lis3de_fifo_ctrl_reg_t fifo_ctrl_reg;
+  int32_t ret;
+
+  lis3de_lock(ctx);
+
+  ret = lis3de_read_reg(ctx, LIS3DE_FIFO_CTRL_REG,
+                        (uint8_t *)&fifo_ctrl_reg, 1);
+
+  if (ret == 0)
+  {
+    fifo_ctrl_reg.fth = val;
+    ret = lis3de_write_reg(ctx, LIS3DE_FIFO_CTRL_REG,
+                           (uint8_t *)&fifo_ctrl_reg, 1);
+  }
+
+  lis3de_unlock(ctx);
+
+  return ret;
+}
+
+/**
+  * @brief  FIFO watermark level selection.[get]
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      change the values of fth in reg FIFO_CTRL_REG
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lis3de_fifo_watermark_get(const stmdev_ctx_t *ctx, uint8_t *val)
+{
+  lis3de_fifo_ctrl_reg_t fifo_ctrl_reg;
+  int32_t ret;
+
+  ret = lis3de_read_reg(ctx, LIS3DE_FIFO_CTRL_REG,
+                        (uint8_t *)&fifo_ctrl_reg, 1);
+  *val = (uint8_t)fifo_ctrl_reg.fth;
+
+  return ret;
+}
+
+/**
+  * @brief  Trigger FIFO selection.[set]
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      change the values of tr in reg FIFO_CTRL_REG
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lis3de_fifo_trigger_event_set(const stmdev_ctx_t *ctx,
+                                      lis3de_tr_t val)
+{
+  lis3de_fifo_ctrl_reg_t fifo_ctrl_reg;
+  int32_t ret;
+
+  lis3de_lock(ctx);
+
+  ret = lis3de_read_reg(ctx, LIS3DE_FIFO_CTRL_REG,
+                        (uint8_t *)&fifo_ctrl_reg, 1);
+
+  if (ret == 0)
+  {
+    fifo_ctrl_reg.tr = (uint8_t)val;
+    ret = lis3de_write_reg(ctx, LIS3DE_FIFO_CTRL_REG,
+                           (uint8_t *)&fifo_ctrl_reg, 1);
+  }
+
+  lis3de_unlock(ctx);
+
+  return ret;
+}
+
+/**
+  * @brief  Trigger FIFO selection.[get]
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      Get the values of tr in reg FIFO_CTRL_REG
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lis3de_fifo_trigger_event_get(const stmdev_ctx_t *ctx,
+                                      lis3de_tr_t *val)
+{
+  lis3de_fifo_ctrl_reg_t fifo_ctrl_reg;
+  int32_t ret;
+
+  ret = lis3de_read_reg(ctx, LIS3DE_FIFO_CTRL_REG,
+                        (uint8_t *)&fifo_ctrl_reg, 1);
+
+  switch (fifo_ctrl_reg.tr)
+  {
+    case LIS3DE_INT1_GEN:
+      *val = LIS3DE_INT1_GEN;
+      break;
+
+    case LIS3DE_INT2_GEN:
+      *val = LIS3DE_INT2_GEN;
+      break;
+
+    default:
+      *val = LIS3DE_INT1_GEN;
+      break;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  FIFO mode selection.[set]
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      change the values of fm in reg FIFO_CTRL_REG
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lis3de_fifo_mode_set(const stmdev_ctx_t *ctx, lis3de_fm_t val)
+{
+  lis3de_fifo_ctrl_reg_t fifo_ctrl_reg;
+  int32_t ret;
+
+  lis3de_lock(ctx);
+
+  ret = lis3de_read_reg(ctx, LIS3DE_FIFO_CTRL_REG,
+                        (uint8_t *)&fifo_ctrl_reg, 1);
+
+  if (ret == 0)
+  {
+    fifo_ctrl_reg.fm = (uint8_t)val;
+    ret = lis3de_write_reg(ctx, LIS3DE_FIFO_CTRL_REG,
+                           (uint8_t *)&fifo_ctrl_reg, 1);
+  }
+
+  lis3de_unlock(ctx);
+
+  return ret;
+}
+
+/**
+  * @brief  FIFO mode selection.[get]
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      Get the values of fm in reg FIFO_CTRL_REG
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lis3de_fifo_mode_get(const stmdev_ctx_t *ctx, lis3de_fm_t *val)
+{
+  lis3de_fifo_ctrl_reg_t fifo_ctrl_reg;
+  int32_t ret;
+
+  ret = lis3de_read_reg(ctx, LIS3DE_FIFO_CTRL_REG,
+                        (uint8_t *)&fifo_ctrl_reg, 1);
+
+  switch (fifo_ctrl_reg.fm)
+  {
+    case LIS3DE_BYPASS_MODE:
+      *val = LIS3DE_BYPASS_MODE;
+      break;
+
+    case LIS3DE_FIFO_MODE:
+      *val = LIS3DE_FIFO_MODE;
+      break;
+
+    case LIS3DE_DYNAMIC_STREAM_MODE:
+      *val = LIS3DE_DYNAMIC_STREAM_MODE;
+      break;
+
+    case LIS3DE_STREAM_TO_FIFO_MODE:
+      *val = LIS3DE_STREAM_TO_FIFO_MODE;
+      break;
+
+    default:
+      *val = LIS3DE_BYPASS_MODE;
+      break;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  FIFO status register.[get]
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      registers FIFO_SRC_REG
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lis3de_fifo_status_get(const stmdev_ctx_t *ctx,
+                               lis3de_fifo_src_reg_t *val)
+{
+  int32_t ret;
+
+  ret = lis3de_read_reg(ctx, LIS3DE_FIFO_SRC_REG, (uint8_t *) val, 1);
+
+  return ret;
+}
+/**
+  * @brief  FIFO stored data level.[get]
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      change the values of fss in reg FIFO_SRC_REG
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lis3de_fifo_data_level_get(const stmdev_ctx_t *ctx, uint8_t *val)
+{
+  lis3de_fifo_src_reg_t fifo_src_reg;
+  int32_t ret;
+
+  ret = lis3de_read_reg(ctx, LIS3DE_FIFO_SRC_REG,
+                        (uint8_t *)&fifo_src_reg, 1);
+  *val = (uint8_t)fifo_src_reg.fss;
+
+  return ret;
+}
+/**
+  * @brief  Empty FIFO status flag.[get]
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      change the values of empty in reg FIFO_SRC_REG
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lis3de_fifo_empty_flag_get(const stmdev_ctx_t *ctx, uint8_t *val)
+{
+  lis3de_fifo_src_reg_t fifo_src_reg;
+  int32_t ret;
+
+  ret = lis3de_read_reg(ctx, LIS3DE_FIFO_SRC_REG,
+                        (uint8_t *)&fifo_src_reg, 1);
+  *val = (uint8_t)fifo_src_reg.empty;
+
+  return ret;
+}
+/**
+  * @brief  FIFO overrun status flag.[get]
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      change the values of ovrn_fifo in reg FIFO_SRC_REG
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lis3de_fifo_ovr_flag_get(const stmdev_ctx_t *ctx, uint8_t *val)
+{
+  lis3de_fifo_src_reg_t fifo_src_reg;
+  int32_t ret;
+
+  ret = lis3de_read_reg(ctx, LIS3DE_FIFO_SRC_REG,
+                        (uint8_t *)&fifo_src_reg, 1);
+  *val = (uint8_t)fifo_src_reg.ovrn_fifo;
+
+  return ret;
+}
+/**
+  * @brief  FIFO watermark status.[get]
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      change the values of wtm in reg FIFO_SRC_REG
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lis3de_fifo_fth_flag_get(const stmdev_ctx_t *ctx, uint8_t *val)
+{
+  lis3de_fifo_src_reg_t fifo_src_reg;
+  int32_t ret;
+
+  ret = lis3de_read_reg(ctx, LIS3DE_FIFO_SRC_REG,
+                        (uint8_t *)&fifo_src_reg, 1);
+  *val = (uint8_t)fifo_src_reg.wtm;
+
+  return ret;
+}
+
+/**
+  * @brief  Number of samples to drain according to FIFO_SRC_REG.
+  *
+  * @param  src      FIFO_SRC_REG content
+  * @param  max      maximum number of samples requested
+  * @retval          samples to read
+  *
+  */
+static uint8_t lis3de_fifo_count(const lis3de_fifo_src_reg_t *src,
+                                 uint8_t max)
+{
+  uint8_t num;
+
+  /* overrun means the FIFO is full with 32 unread samples */
+  if (src->ovrn_fifo == PROPERTY_ENABLE)
+  {
+    num = LIS3DE_FIFO_SIZE;
+  }
+
+  else
+  {
+    num = (uint8_t)src->fss;
+  }
+
+  if (num > max)
+  {
+    num = max;
+  }
+
+  return num;
+}
+
+/**
+  * @brief  De-interleave in place num samples burst read over
+  *         OUT_X_L..OUT_Z, keeping the high byte of each axis.
+  *
+  * @param  xyz      buffer holding 6 * num raw bytes, 3 * num items out
+  * @param  num      number of samples
+  *
+  */
+static void lis3de_xyz_unpack(int16_t *xyz, uint8_t num)
+{
+  const int8_t *raw = (const int8_t *)xyz;
+  uint16_t i;
+
+  /* each item is written after the byte it overlaps has been read */
+  for (i = 0U; i < ((uint16_t)num * 3U); i++)
+  {
+    xyz[i] = raw[(i * 2U) + 1U];
+  }
+}
+
+/**
+  * @brief  Read FIFO_SRC_REG once and drain the stored samples.
+  *         With multi-byte access the device rolls the address back from
+  *         OUT_Z to OUT_X_L after each sample, so the whole batch is read
+  *         in one burst straight into xyz and de-interleaved in place.
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  xyz      buffer of 3 * max items that stores data read
+  * @param  max      maximum number of samples to read
+  * @param  count    number of samples read
+  * @param  src      FIFO_SRC_REG content read before the drain
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+static int32_t lis3de_fifo_drain(const stmdev_ctx_t *ctx, int16_t *xyz,
+                                 uint8_t max, uint8_t *count,
+                                 lis3de_fifo_src_reg_t *src)
+{
+  uint8_t inc = lis3de_multi_rw(ctx);
+  uint8_t num = 0U;
+  uint8_t i;
+  int32_t ret;
+
+  lis3de_lock(ctx);
+
+  ret = lis3de_read_reg(ctx, LIS3DE_FIFO_SRC_REG, (uint8_t *)src, 1);
+
+  if (ret == 0)
+  {
+    num = lis3de_fifo_count(src, max);
+  }
+
+  if ((ret == 0) && (num > 0U))
+  {
+    if (inc != 0U)
+    {
+      ret = lis3de_read_reg(ctx, (uint8_t)(LIS3DE_OUT_X_L | inc),
+                            (uint8_t *)xyz, (uint16_t)num * 6U);
+      lis3de_xyz_unpack(xyz, num);
+    }
+
+    else
+    {
+      for (i = 0U; (i < num) && (ret == 0); i++)
+      {
+        ret = lis3de_acceleration_raw_get(ctx, &xyz[(uint16_t)i * 3U]);
+      }
+    }
+  }
+
+  *count = num;
+
+  lis3de_unlock(ctx);
+
+  return ret;
+}
+
+/**
+  * @brief  Drain the FIFO in as few transactions as possible.[get]
+  *         Samples are stored interleaved (X, Y, Z) in xyz.
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  xyz      buffer of 3 * max items that stores data read
+  * @param  max      maximum number of samples to read
+  * @param  count    number of samples read
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lis3de_fifo_read_batch(const stmdev_ctx_t *ctx, int16_t *xyz,
+                               uint8_t max, uint8_t *count)
+{
+  lis3de_fifo_src_reg_t fifo_src_reg;
+  int32_t ret;
+
+  ret = lis3de_fifo_drain(ctx, xyz, max, count, &fifo_src_reg);
+
+  return ret;
+}
+
+/**
+  * @brief  Store one sample in the layout of an output descriptor.
+  *
+  * @param  out      output descriptor
+  * @param  idx      sample index
+  * @param  xyz      X, Y, Z of the sample
+  * @param  sens     mg/LSB, float layout only
+  *
+  */
+static void lis3de_fifo_out_put(const lis3de_fifo_out_t *out, uint16_t idx,
+                                const int16_t *xyz, float_t sens)
+{
+  uint16_t stride = out->stride;
+  uint8_t axis;
+
+  for (axis = 0U; axis < 3U; axis++)
+  {
+    switch (out->fmt)
+    {
+      case LIS3DE_FIFO_OUT_S8:
+        stride = (stride == 0U) ? 3U : stride;
+        ((int8_t *)out->axis[0])[(idx * stride) + axis] = (int8_t)xyz[axis];
+        break;
+
+      case LIS3DE_FIFO_OUT_S16_PLANAR:
+        stride = (stride == 0U) ? 1U : stride;
+        ((int16_t *)out->axis[axis])[idx * stride] = xyz[axis];
+        break;
+
+      case LIS3DE_FIFO_OUT_MG_PLANAR:
+        stride = (stride == 0U) ? 1U : stride;
+        ((float_t *)out->axis[axis])[idx * stride] =
+          (float_t)xyz[axis] * sens;
+        break;
+
+      case LIS3DE_FIFO_OUT_S16:
+      default:
+        stride = (stride == 0U) ? 3U : stride;
+        ((int16_t *)out->axis[0])[(idx * stride) + axis] = xyz[axis];
+        break;
+    }
+  }
+}
+
+/**
+  * @brief  Drain the FIFO into the layout of an output descriptor.[get]
+  *         Packed interleaved int16 is de-interleaved in place in the
+  *         output; any other layout is written straight from the bus
+  *         buffer of the descriptor, one burst per drain, without
+  *         intermediate copies.
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  out      output descriptor
+  * @param  max      maximum number of samples to read
+  * @param  count    number of samples read
+  * @retval          interface status, -1 if a bus buffer is required
+  *
+  */
+int32_t lis3de_fifo_read_out(const stmdev_ctx_t *ctx,
+                             const lis3de_fifo_out_t *out, uint8_t max,
+                             uint8_t *count)
+{
+  lis3de_fifo_src_reg_t fifo_src_reg;
+  const int8_t *bus = (const int8_t *)out->bus;
+  float_t sens = lis3de_fs_sensitivity(out->fs);
+  uint8_t inc = lis3de_multi_rw(ctx);
+  int16_t xyz[3];
+  uint16_t i;
+  uint8_t num = 0U;
+  uint8_t stored = 0U;
+  int32_t ret;
+
+  if ((out->fmt == LIS3DE_FIFO_OUT_S16) && (bus == NULL) &&
+      ((out->stride == 0U) || (out->stride == 3U)))
+  {
+    ret = lis3de_fifo_drain(ctx, (int16_t *)out->axis[0], max, count,
+                            &fifo_src_reg);
+  }
+
+  else if ((inc != 0U) && (bus == NULL))
+  {
+    *count = 0U;
+    ret = -1;
+  }
+
+  else
+  {
+    lis3de_lock(ctx);
+
+    ret = lis3de_read_reg(ctx, LIS3DE_FIFO_SRC_REG,
+                          (uint8_t *)&fifo_src_reg, 1);
+
+    if (ret == 0)
+    {
+      num = lis3de_fifo_count(&fifo_src_reg, max);
+    }
+
+    if ((ret == 0) && (num > 0U) && (inc != 0U))
+    {
+      ret = lis3de_read_reg(ctx, (uint8_t)(LIS3DE_OUT_X_L | inc),
+                            out->bus, (uint16_t)num * 6U);
+
+      for (i = 0U; (i < num) && (ret == 0); i++)
+      {
+        xyz[0] = bus[(i * 6U) + 1U];
+        xyz[1] = bus[(i * 6U) + 3U];
+        xyz[2] = bus[(i * 6U) + 5U];
+        lis3de_fifo_out_put(out, i, xyz, sens);
+        stored++;
+      }
+    }
+
+    else
+    {
+      for (i = 0U; (i < num) && (ret == 0); i++)
+      {
+        ret = lis3de_acceleration_raw_get(ctx, xyz);
+
+        if (ret == 0)
+        {
+          lis3de_fifo_out_put(out, i, xyz, sens);
+          stored++;
+        }
+      }
+    }
+
+    /* samples actually stored in the output */
+    *count = stored;
+
+    lis3de_unlock(ctx);
+  }
+
+  return ret;
+}
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup  LIS3DE_Stream
+  * @brief     This section group the functions of the watermark driven
+  *            streaming layer. The INT1 watermark ISR fills one of two
+  *            caller allocated blocks while the application processes
+  *            the other one.
+  * @{
+  *
+  */
+
+/**
+  * @brief  Streaming layer initialization.
+  *
+  * @param  stream   streaming layer object
+  * @param  ctx      read / write interface definitions
+  * @param  buf0     first block, 3 * size items
+  * @param  buf1     second block, 3 * size items
+  * @param  size     capacity of each block in samples (1 - 32)
+  * @retval          0 -> no Error, -1 -> invalid arguments
+  *
+  */
+int32_t lis3de_stream_init(lis3de_stream_t *stream, const stmdev_ctx_t *ctx,
+                           int16_t *buf0, int16_t *buf1, uint8_t size)
+{
+  int32_t ret = 0;
+
+  if ((stream == NULL) || (buf0 == NULL) || (buf1 == NULL) ||
+      (size == 0U) || (size > LIS3DE_FIFO_SIZE))
+  {
+    ret = -1;
+  }
+
+  else
+  {
+    stream->ctx = ctx;
+    stream->block[0].xyz = buf0;
+    stream->block[0].count = 0U;
+    stream->block[0].ready = 0U;
+    stream->block[1].xyz = buf1;
+    stream->block[1].count = 0U;
+    stream->block[1].ready = 0U;
+    stream->size = size;
+    stream->fill = 0U;
+    stream->next = 0U;
+    stream->stalls = 0U;
+    stream->stall_pending = 0U;
+    stream->aux_div = 0U;
+    stream->aux_cnt = 0U;
+    stream->block[0].aux_valid = 0U;
+    stream->block[1].aux_valid = 0U;
+    stream->period = 0U;
+    stream->last_tick = 0U;
+    stream->leftover = 0U;
+    stream->lost = 0U;
+    stream->aux_errors = 0U;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Start streaming: FIFO in dynamic stream mode with watermark
+  *         routed on INT1 pin.
+  *
+  * @param  stream   streaming layer object
+  * @param  wtm      FIFO watermark level, must not exceed the block size
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lis3de_stream_start(lis3de_stream_t *stream, uint8_t wtm)
+{
+  lis3de_ctrl_reg3_t ctrl_reg3;
+  int32_t ret;
+
+  lis3de_lock(stream->ctx);
+
+  if (wtm > stream->size)
+  {
+    ret = -1;
+  }
+
+  else
+  {
+    /* bypass first to discard stale samples */
+    ret = lis3de_fifo_mode_set(stream->ctx, LIS3DE_BYPASS_MODE);
+  }
+
+  if (ret == 0)
+  {
+    ret = lis3de_fifo_set(stream->ctx, PROPERTY_ENABLE);
+  }
+
+  if (ret == 0)
+  {
+    ret = lis3de_fifo_watermark_set(stream->ctx, wtm);
+  }
+
+  if (ret == 0)
+  {
+    ret = lis3de_fifo_mode_set(stream->ctx, LIS3DE_DYNAMIC_STREAM_MODE);
+  }
+
+  if (ret == 0)
+  {
+    ret = lis3de_pin_int1_config_get(stream->ctx, &ctrl_reg3);
+  }
+
+  if (ret == 0)
+  {
+    ctrl_reg3.int1_wtm = PROPERTY_ENABLE;
+    ret = lis3de_pin_int1_config_set(stream->ctx, &ctrl_reg3);
+  }
+
+  if (ret == 0)
+  {
+    /* the FIFO restarts empty */
+    stream->last_tick = lis3de_tick(stream->ctx);
+    stream->leftover = 0U;
+  }
+
+  lis3de_unlock(stream->ctx);
+
+  return ret;
+}
+
+/**
+  * @brief  Stop streaming: watermark removed from INT1 pin and FIFO back
+  *         in bypass mode. Blocks not yet released are kept.
+  *
+  * @param  stream   streaming layer object
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lis3de_stream_stop(lis3de_stream_t *stream)
+{
+  lis3de_ctrl_reg3_t ctrl_reg3;
+  int32_t ret;
+
+  lis3de_lock(stream->ctx);
+
+  ret = lis3de_pin_int1_config_get(stream->ctx, &ctrl_reg3);
+
+  if (ret == 0)
+  {
+    ctrl_reg3.int1_wtm = PROPERTY_DISABLE;
+    ret = lis3de_pin_int1_config_set(stream->ctx, &ctrl_reg3);
+  }
+
+  if (ret == 0)
+  {
+    ret = lis3de_fifo_mode_set(stream->ctx, LIS3DE_BYPASS_MODE);
+  }
+
+  lis3de_unlock(stream->ctx);
+
+  return ret;
+}
+
+/**
+  * @brief  Gap accounting of a drain. In stream mode an overrun only
+  *         overwrites the oldest samples and the FIFO keeps running, so
+  *         no mode toggle is needed: the lost samples are those that
+  *         arrived since the previous drain, plus the ones it left in
+  *         the FIFO, beyond the 32 levels.
+  *
+  * @param  stream   stream object
+  * @param  blk      block just drained
+  * @param  src      FIFO_SRC_REG read by the drain
+  *
+  */
+static void lis3de_stream_gap(lis3de_stream_t *stream,
+                              lis3de_stream_block_t *blk,
+                              const lis3de_fifo_src_reg_t *src)
+{
+  const lis3de_priv_t *priv = (const lis3de_priv_t *)stream->ctx->priv_data;
+  uint32_t now = lis3de_tick(stream->ctx);
+  uint32_t total;
+
+  blk->overrun = src->ovrn_fifo;
+  blk->gap = 0U;
+
+  if (src->ovrn_fifo == PROPERTY_ENABLE)
+  {
+    /* without a time base the elapsed samples are not known */
+    if ((stream->period == 0U) || (priv == NULL) || (priv->tick == NULL))
+    {
+      blk->gap = LIS3DE_GAP_UNKNOWN;
+    }
+
+    else
+    {
+      total = stream->leftover +
+              (((now - stream->last_tick) + (stream->period / 2U)) /
+               stream->period);
+      blk->gap = (total > LIS3DE_FIFO_SIZE) ? (total - LIS3DE_FIFO_SIZE) :
+                 0U;
+      stream->lost += blk->gap;
+    }
+  }
+
+  stream->leftover = lis3de_fifo_count(src, LIS3DE_FIFO_SIZE) - blk->count;
+  stream->last_tick = now;
+}
+
+/**
+  * @brief  Sample period used to size the gaps after an overrun, e.g.
+  *         the nominal 1 / ODR or the lis3de_ts_t estimate, in
+  *         lis3de_priv_t.tick units.
+  *
+  * @param  stream   stream object
+  * @param  period   sample period, 0 -> gaps reported unknown (as
+  *                  without lis3de_priv_t.tick)
+  *
+  */
+void lis3de_stream_period_set(lis3de_stream_t *stream, uint32_t period)
+{
+  stream->period = period;
+}
+
+/**
+  * @brief  Read the auxiliary channels into the side-band of a block:
+  *         STATUS_REG_AUX and OUT_ADC1 .. OUT_ADC3 are consecutive, one
+  *         burst with multi-byte access.
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  blk      block being filled
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+static int32_t lis3de_stream_aux_read(const stmdev_ctx_t *ctx,
+                                      lis3de_stream_block_t *blk)
+{
+  uint8_t buff[7];
+  uint8_t i;
+  int32_t ret;
+
+  ret = lis3de_read_regs(ctx, LIS3DE_STATUS_REG_AUX, buff, 7);
+
+  if (ret == 0)
+  {
+    *(uint8_t *)&blk->aux_status = buff[0];
+
+    for (i = 0U; i < 3U; i++)
+    {
+      blk->adc[i] = (int16_t)((int16_t)((int8_t)buff[(i * 2U) + 2U]) * 256);
+      blk->adc[i] += (int16_t)buff[(i * 2U) + 1U];
+    }
+
+    blk->aux_valid = 1U;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Schedule the auxiliary ADC / temperature read every div
+  *         watermarks, in the same bus session as the FIFO drain; the
+  *         results come with the block as side-band. The ADC must be
+  *         enabled with lis3de_aux_adc_set.
+  *
+  * @param  stream   stream object
+  * @param  div      drains between two auxiliary reads, 0 to disable
+  *
+  */
+void lis3de_stream_aux_set(lis3de_stream_t *stream, uint8_t div)
+{
+  stream->aux_div = div;
+  stream->aux_cnt = 0U;
+}
+
+/**
+  * @brief  To be called from the INT1 watermark interrupt: drain the
+  *         FIFO into the free block. When both blocks are still owned
+  *         by the application the samples are left in the FIFO and the
+  *         stall counter is incremented.
+  *
+  * @param  stream   streaming layer object
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lis3de_stream_irq_handler(lis3de_stream_t *stream)
+{
+  lis3de_stream_block_t *blk = &stream->block[stream->fill];
+  lis3de_fifo_src_reg_t fifo_src_reg;
+  int32_t ret = 0;
+
+  if (blk->ready != 0U)
+  {
+    stream->stalls++;
+    stream->stall_pending = 1U;
+  }
+
+  else
+  {
+    stream->stall_pending = 0U;
+
+    lis3de_lock(stream->ctx);
+
+    ret = lis3de_fifo_drain(stream->ctx, blk->xyz, stream->size,
+                            &blk->count, &fifo_src_reg);
+    blk->aux_valid = 0U;
+
+    if ((ret == 0) && (blk->count > 0U) && (stream->aux_div != 0U))
+    {
+      stream->aux_cnt++;
+
+      if (stream->aux_cnt >= stream->aux_div)
+      {
+        stream->aux_cnt = 0U;
+
+        /* side-band only: the drained samples are published anyway */
+        if (lis3de_stream_aux_read(stream->ctx, blk) != 0)
+        {
+          stream->aux_errors++;
+        }
+      }
+    }
+
+    lis3de_unlock(stream->ctx);
+
+    if (ret == 0)
+    {
+      lis3de_stream_gap(stream, blk, &fifo_src_reg);
+    }
+
+    if ((ret == 0) && (blk->count > 0U))
+    {
+      blk->ready = 1U;
+      stream->fill ^= 1U;
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Oldest block filled by the ISR.
+  *
+  * @param  stream   streaming layer object
+  * @retval          block to process, NULL if none is ready
+  *
+  */
+lis3de_stream_block_t *lis3de_stream_poll(lis3de_stream_t *stream)
+{
+  lis3de_stream_block_t *blk = &stream->block[stream->next];
+
+  if (blk->ready == 0U)
+  {
+    blk = NULL;
+  }
+
+  return blk;
+}
+
+/**
+  * @brief  Give a block returned by lis3de_stream_poll back to the ISR.
+  *         If a watermark was skipped meanwhile (both blocks busy), the
+  *         still asserted watermark raises no new edge on INT1 and the
+  *         stream would stop: the watermark is then removed from and
+  *         routed again on INT1, so that the pin gives a new edge and
+  *         the ISR drains the FIFO. The drain never runs here.
+  *
+  * @param  stream   streaming layer object
+  * @param  blk      block to release
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lis3de_stream_release_block(lis3de_stream_t *stream,
+                                    lis3de_stream_block_t *blk)
+{
+  lis3de_ctrl_reg3_t ctrl_reg3;
+  int32_t ret = 0;
+
+  if (blk == &stream->block[stream->next])
+  {
+    blk->count = 0U;
+    blk->ready = 0U;
+    stream->next ^= 1U;
+
+    if (stream->stall_pending != 0U)
+    {
+      stream->stall_pending = 0U;
+
+      lis3de_lock(stream->ctx);
+
+      ret = lis3de_pin_int1_config_get(stream->ctx, &ctrl_reg3);
+
+      if (ret == 0)
+      {
+        ctrl_reg3.int1_wtm = PROPERTY_DISABLE;
+        ret = lis3de_pin_int1_config_set(stream->ctx, &ctrl_reg3);
+      }
+
+      if (ret == 0)
+      {
+        /* INT1 rises again: the ISR drains into the released block */
+        ctrl_reg3.int1_wtm = PROPERTY_ENABLE;
+        ret = lis3de_pin_int1_config_set(stream->ctx, &ctrl_reg3);
+      }
+
+      lis3de_unlock(stream->ctx);
+
+      if (ret != 0)
+      {
+        stream->stall_pending = 1U;
+      }
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup  LIS3DE_Async
+  * @brief     This section group the non-blocking variants of the data-path
+  *            functions. They need multi-byte access and the read_reg_async
+  *            entry in lis3de_priv_t; data are decoded in the completion
+  *            callback, then the user done callback is invoked.
+  *            The request object must stay valid until done is called.
+  * @{
+  *
+  */
+
+/**
+  * @brief  Start a non-blocking read on the bus.
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  reg      register to read
+  * @param  data     buffer that stores data read
+  * @param  len      number of consecutive register to read
+  * @param  done     completion callback
+  * @param  user     completion callback argument
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+static int32_t lis3de_read_reg_async(const stmdev_ctx_t *ctx, uint8_t reg,
+                                     uint8_t *data, uint16_t len,
+                                     lis3de_done_ptr done, void *user)
+{
+  const lis3de_priv_t *priv;
+  int32_t ret = -1;
+
+  if ((ctx != NULL) && (ctx->priv_data != NULL))
+  {
+    priv = (const lis3de_priv_t *)ctx->priv_data;
+
+    if (priv->read_reg_async != NULL)
+    {
+      ret = priv->read_reg_async(ctx->handle,
+                                 lis3de_bus_addr(ctx, reg, len, 1U),
+                                 data, len, done, user);
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Acceleration burst read completed: decode the three axes.
+  *
+  * @param  status   interface status of the read
+  * @param  user     request object
+  *
+  */
+static void lis3de_acceleration_raw_done(int32_t status, void *user)
+{
+  lis3de_async_t *req = (lis3de_async_t *)user;
+
+  if (status == 0)
+  {
+    req->xyz[0] = req->raw[1];
+    req->xyz[1] = req->raw[3];
+    req->xyz[2] = req->raw[5];
+  }
+
+  req->done(status, req->user);
+}
+
+/**
+  * @brief  Acceleration output value, non-blocking.[get]
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  req      request object, owned by the driver until done
+  * @param  buff     buffer that stores data read
+  * @param  done     called once buff holds the decoded data
+  * @param  user     done callback argument
+  * @retval          0 -> transfer started, otherwise not started
+  *
+  */
+int32_t lis3de_acceleration_raw_get_async(const stmdev_ctx_t *ctx,
+                                          lis3de_async_t *req,
+                                          int16_t *buff,
+                                          lis3de_done_ptr done, void *user)
+{
+  uint8_t inc = lis3de_multi_rw(ctx);
+  int32_t ret = -1;
+
+  if (inc != 0U)
+  {
+    req->ctx = ctx;
+    req->done = done;
+    req->user = user;
+    req->xyz = buff;
+    ret = lis3de_read_reg_async(ctx, (uint8_t)(LIS3DE_OUT_X_L | inc),
+                                (uint8_t *)req->raw, 6,
+                                lis3de_acceleration_raw_done, req);
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  FIFO status register, non-blocking.[get]
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  req      request object, owned by the driver until done
+  * @param  val      registers FIFO_SRC_REG
+  * @param  done     called once val holds the register content
+  * @param  user     done callback argument
+  * @retval          0 -> transfer started, otherwise not started
+  *
+  */
+int32_t lis3de_fifo_status_get_async(const stmdev_ctx_t *ctx,
+                                     lis3de_async_t *req,
+                                     lis3de_fifo_src_reg_t *val,
+                                     lis3de_done_ptr done, void *user)
+{
+  int32_t ret;
+
+  req->ctx = ctx;
+  req->done = done;
+  req->user = user;
+  ret = lis3de_read_reg_async(ctx, LIS3DE_FIFO_SRC_REG, (uint8_t *)val, 1,
+                              done, user);
+
+  return ret;
+}
+
+/**
+  * @brief  FIFO burst read completed: de-interleave the samples.
+  *
+  * @param  status   interface status of the read
+  * @param  user     request object
+  *
+  */
+static void lis3de_fifo_data_done(int32_t status, void *user)
+{
+  lis3de_async_t *req = (lis3de_async_t *)user;
+
+  if (status == 0)
+  {
+    lis3de_xyz_unpack(req->xyz, *req->count);
+  }
+
+  req->done(status, req->user);
+}
+
+/**
+  * @brief  FIFO_SRC_REG read completed: start the burst read of the
+  *         stored samples, or report completion if there is none.
+  *
+  * @param  status   interface status of the FIFO_SRC_REG read
+  * @param  user     request object
+  *
+  */
+static void lis3de_fifo_src_done(int32_t status, void *user)
+{
+  lis3de_async_t *req = (lis3de_async_t *)user;
+  uint8_t inc = lis3de_multi_rw(req->ctx);
+  uint8_t pending = 0U;
+  int32_t ret = status;
+
+  *req->count = 0U;
+
+  if (ret == 0)
+  {
+    *req->count = lis3de_fifo_count(&req->fifo_src_reg, req->max);
+
+    if (*req->count > 0U)
+    {
+      ret = lis3de_read_reg_async(req->ctx,
+                                  (uint8_t)(LIS3DE_OUT_X_L | inc),
+                                  (uint8_t *)req->xyz,
+                                  (uint16_t)(*req->count) * 6U,
+                                  lis3de_fifo_data_done, req);
+
+      if (ret == 0)
+      {
+        pending = 1U;
+      }
+    }
+  }
+
+  /* otherwise completion is reported by lis3de_fifo_data_done */
+  if (pending == 0U)
+  {
+    req->done(ret, req->user);
+  }
+}
+
+/**
+  * @brief  Drain the FIFO, non-blocking.[get]
+  *         FIFO_SRC_REG is read first, then the stored samples are read in
+  *         one burst and de-interleaved in xyz before done is called.
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  req      request object, owned by the driver until done
+  * @param  xyz      buffer of 3 * max items that stores data read
+  * @param  max      maximum number of samples to read
+  * @param  count    number of samples read, valid when done is called
+  * @param  done     completion callback
+  * @param  user     done callback argument
+  * @retval          0 -> transfer started, otherwise not started
+  *
+  */
+int32_t lis3de_fifo_read_batch_async(const stmdev_ctx_t *ctx,
+                                     lis3de_async_t *req, int16_t *xyz,
+                                     uint8_t max, uint8_t *count,
+                                     lis3de_done_ptr done, void *user)
+{
+  int32_t ret = -1;
+
+  if (lis3de_multi_rw(ctx) != 0U)
+  {
+    req->ctx = ctx;
+    req->done = done;
+    req->user = user;
+    req->xyz = xyz;
+    req->max = max;
+    req->count = count;
+    ret = lis3de_read_reg_async(ctx, LIS3DE_FIFO_SRC_REG,
+                                (uint8_t *)&req->fifo_src_reg, 1,
+                                lis3de_fifo_src_done, req);
+  }
+
+  return ret;
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup  LIS3DE_Scheduler
+  * @brief     This section group the functions that share one bus among
+  *            several devices: watermark events are collected from the
+  *            ISRs and the FIFO drains are run back-to-back, nearest
+  *            overrun deadline first.
+  * @{
+  *
+  */
+
+/**
+  * @brief  Scheduler initialization.
+  *
+  * @param  sched    scheduler object
+  * @param  dev      caller allocated device table
+  * @param  num      number of devices in the table
+  * @param  tick     time base, also the unit of the device sample period
+  * @param  cb       called with the samples of each drain
+  * @param  user     callback argument
+  * @retval          0 -> no Error, -1 -> invalid arguments
+  *
+  */
+int32_t lis3de_sched_init(lis3de_sched_t *sched, lis3de_sched_dev_t *dev,
+                          uint8_t num, lis3de_tick_ptr tick,
+                          lis3de_sched_cb_t cb, void *user)
+{
+  uint8_t i;
+  int32_t ret = 0;
+
+  if ((sched == NULL) || (dev == NULL) || (tick == NULL) || (cb == NULL))
+  {
+    ret = -1;
+  }
+
+  else
+  {
+    sched->dev = dev;
+    sched->num = num;
+    sched->tick = tick;
+    sched->cb = cb;
+    sched->user = user;
+
+    /* slots stay unused until lis3de_sched_dev_set */
+    for (i = 0U; i < num; i++)
+    {
+      dev[i].ctx = NULL;
+      dev[i].xyz = NULL;
+      dev[i].pending = 0U;
+      dev[i].event_tick = 0U;
+      dev[i].latency_last = 0U;
+      dev[i].latency_max = 0U;
+      dev[i].drains = 0U;
+      dev[i].overruns = 0U;
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Register a device in the scheduler table.
+  *
+  * @param  sched    scheduler object
+  * @param  idx      device index in the table
+  * @param  ctx      read / write interface definitions of the device
+  * @param  xyz      drain buffer, 3 * LIS3DE_FIFO_SIZE items
+  * @param  period   sample period (1 / ODR) in tick units
+  * @param  wtm      FIFO watermark level configured on the device
+  * @retval          0 -> no Error, -1 -> invalid arguments
+  *
+  */
+int32_t lis3de_sched_dev_set(lis3de_sched_t *sched, uint8_t idx,
+                             const stmdev_ctx_t *ctx, int16_t *xyz,
+                             uint32_t period, uint8_t wtm)
+{
+  lis3de_sched_dev_t *dev;
+  int32_t ret = 0;
+
+  if ((idx >= sched->num) || (xyz == NULL) || (wtm > LIS3DE_FIFO_SIZE))
+  {
+    ret = -1;
+  }
+
+  else
+  {
+    dev = &sched->dev[idx];
+    dev->ctx = ctx;
+    dev->xyz = xyz;
+    dev->period = period;
+    dev->wtm = wtm;
+    dev->pending = 0U;
+    dev->event_tick = 0U;
+    dev->latency_last = 0U;
+    dev->latency_max = 0U;
+    dev->drains = 0U;
+    dev->overruns = 0U;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  To be called from the watermark interrupt of a device.
+  *
+  * @param  sched    scheduler object
+  * @param  idx      device index in the table
+  *
+  */
+void lis3de_sched_notify(lis3de_sched_t *sched, uint8_t idx)
+{
+  if (idx < sched->num)
+  {
+    sched->dev[idx].event_tick = sched->tick();
+    sched->dev[idx].pending = 1U;
+  }
+}
+
+/**
+  * @brief  Drain all the pending devices. The device whose FIFO would
+  *         overrun first, (32 - watermark) periods after its event, is
+  *         served first; events raised meanwhile are served in the same
+  *         call. Drain latency is measured from event to drain start.
+  *
+  * @param  sched    scheduler object
+  * @retval          interface status of the last failed drain, 0 if none
+  *
+  */
+int32_t lis3de_sched_run(lis3de_sched_t *sched)
+{
+  lis3de_fifo_src_reg_t fifo_src_reg;
+  lis3de_sched_dev_t *dev;
+  uint32_t deadline;
+  uint32_t best_deadline = 0U;
+  uint32_t now;
+  uint8_t best;
+  uint8_t count;
+  uint8_t i;
+  int32_t ret = 0;
+  int32_t err;
+
+  do
+  {
+    best = sched->num;
+
+    for (i = 0U; i < sched->num; i++)
+    {
+      dev = &sched->dev[i];
+
+      if ((dev->pending != 0U) && (dev->ctx != NULL))
+      {
+        deadline = dev->event_tick +
+                   ((LIS3DE_FIFO_SIZE - (uint32_t)dev->wtm) * dev->period);
+
+        /* wrap-safe comparison of tick values */
+        if ((best == sched->num) ||
+            ((int32_t)(deadline - best_deadline) < 0))
+        {
+          best = i;
+          best_deadline = deadline;
+        }
+      }
+    }
+
+    if (best < sched->num)
+    {
+      dev = &sched->dev[best];
+      dev->pending = 0U;
+      now = sched->tick();
+      dev->latency_last = now - dev->event_tick;
+
+      if (dev->latency_last > dev->latency_max)
+      {
+        dev->latency_max = dev->latency_last;
+      }
+
+      err = lis3de_fifo_drain(dev->ctx, dev->xyz, LIS3DE_FIFO_SIZE,
+                              &count, &fifo_src_reg);
+
+      if (err == 0)
+      {
+        dev->drains++;
+
+        if (fifo_src_reg.ovrn_fifo == PROPERTY_ENABLE)
+        {
+          dev->overruns++;
+        }
+
+        sched->cb(best, dev->xyz, count, sched->user);
+      }
+
+      else
+      {
+        ret = err;
+      }
+    }
+  } while (best < sched->num);
+
+  return ret;
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup  LIS3DE_Ring
+  * @brief     This section group the functions of the single-producer /
+  *            single-consumer sample ring. The producer (typically an
+  *            ISR) only writes head, the consumer only writes tail, so
+  *            neither side ever waits for the other.
+  * @{
+  *
+  */
+
+/**
+  * @brief  Ring initialization.
+  *
+  * @param  ring     ring object
+  * @param  buf      caller allocated slots
+  * @param  size     number of slots, power of 2
+  * @retval          0 -> no Error, -1 -> invalid arguments
+  *
+  */
+int32_t lis3de_ring_init(lis3de_ring_t *ring, lis3de_sample_t *buf,
+                         uint32_t size)
+{
+  int32_t ret = 0;
+
+  if ((buf == NULL) || (size == 0U) || ((size & (size - 1U)) != 0U))
+  {
+    ret = -1;
+  }
+
+  else
+  {
+    ring->buf = buf;
+    ring->mask = size - 1U;
+    ring->head = 0U;
+    ring->tail = 0U;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Publish a sample (producer side).
+  *
+  * @param  ring     ring object
+  * @param  sample   sample to copy in the ring
+  * @retval          0 -> no Error, -1 -> ring full, sample dropped
+  *
+  */
+int32_t lis3de_ring_put(lis3de_ring_t *ring, const lis3de_sample_t *sample)
+{
+  volatile lis3de_sample_t *slot;
+  uint32_t head = ring->head;
+  int32_t ret = 0;
+
+  if ((head - ring->tail) > ring->mask)
+  {
+    ret = -1;
+  }
+
+  else
+  {
+    slot = &ring->buf[head & ring->mask];
+    slot->timestamp = sample->timestamp;
+    slot->xyz[0] = sample->xyz[0];
+    slot->xyz[1] = sample->xyz[1];
+    slot->xyz[2] = sample->xyz[2];
+    slot->zyxda = sample->zyxda;
+    slot->zyxor = sample->zyxor;
+    LIS3DE_RING_BARRIER();
+    ring->head = head + 1U;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Take the oldest sample (consumer side).
+  *
+  * @param  ring     ring object
+  * @param  sample   sample copied out of the ring
+  * @retval          0 -> no Error, -1 -> ring empty
+  *
+  */
+int32_t lis3de_ring_get(lis3de_ring_t *ring, lis3de_sample_t *sample)
+{
+  const volatile lis3de_sample_t *slot;
+  uint32_t tail = ring->tail;
+  int32_t ret = 0;
+
+  if (tail == ring->head)
+  {
+    ret = -1;
+  }
+
+  else
+  {
+    LIS3DE_RING_BARRIER();
+    slot = &ring->buf[tail & ring->mask];
+    sample->timestamp = slot->timestamp;
+    sample->xyz[0] = slot->xyz[0];
+    sample->xyz[1] = slot->xyz[1];
+    sample->xyz[2] = slot->xyz[2];
+    sample->zyxda = slot->zyxda;
+    sample->zyxor = slot->zyxor;
+    LIS3DE_RING_BARRIER();
+    ring->tail = tail + 1U;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Number of samples waiting in the ring, a snapshot that is
+  *         exact only from the consumer side.
+  *
+  * @param  ring     ring object
+  * @retval          number of samples
+  *
+  */
+uint32_t lis3de_ring_count(const lis3de_ring_t *ring)
+{
+  return ring->head - ring->tail;
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup  LIS3DE_Decimation
+  * @brief     This section group the functions of the fixed-point
+  *            decimation stage applied in place to the interleaved
+  *            (X, Y, Z) blocks of a FIFO drain.
+  * @{
+  *
+  */
+
+/**
+  * @brief  Decimator initialization.
+  *
+  * @param  dec      decimator object
+  * @param  coef     low-pass FIR taps, Q15; NULL -> boxcar of factor
+  *                  taps (first order CIC)
+  * @param  taps     number of taps, up to LIS3DE_DECIM_TAPS_MAX
+  * @param  factor   decimation factor
+  * @retval          0 -> no Error, -1 -> invalid arguments
+  *
+  */
+int32_t lis3de_decim_init(lis3de_decim_t *dec, const int16_t *coef,
+                          uint8_t taps, uint8_t factor)
+{
+  uint8_t axis;
+  uint8_t i;
+  int32_t ret = 0;
+
+  if (coef == NULL)
+  {
+    taps = factor;
+  }
+
+  if ((factor == 0U) || (taps == 0U) || (taps > LIS3DE_DECIM_TAPS_MAX))
+  {
+    ret = -1;
+  }
+
+  else
+  {
+    dec->coef = coef;
+    dec->taps = taps;
+    dec->factor = factor;
+    dec->phase = 0U;
+    dec->pos = 0U;
+
+    for (axis = 0U; axis < 3U; axis++)
+    {
+      for (i = 0U; i < LIS3DE_DECIM_TAPS_MAX; i++)
+      {
+        dec->hist[axis][i] = 0;
+      }
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Filter output of one axis, rounded and saturated.
+  *
+  * @param  dec      decimator object
+  * @param  axis     axis index
+  * @retval          filtered sample
+  *
+  */
+static int16_t lis3de_decim_out(const lis3de_decim_t *dec, uint8_t axis)
+{
+  const int16_t *hist = dec->hist[axis];
+  uint8_t idx = dec->pos;
+  uint8_t k;
+  int32_t acc = 0;
+  int32_t out;
+
+  /* newest sample first, hist is a circular buffer ending at pos - 1 */
+  for (k = 0U; k < dec->taps; k++)
+  {
+    idx = (idx == 0U) ? (dec->taps - 1U) : (idx - 1U);
+
+    if (dec->coef != NULL)
+    {
+      acc += (int32_t)dec->coef[k] * hist[idx];
+    }
+
+    else
+    {
+      acc += hist[idx];
+    }
+  }
+
+  if (dec->coef != NULL)
+  {
+    out = (acc >= 0) ? ((acc + 16384) / 32768) : -((16384 - acc) / 32768);
+  }
+
+  else
+  {
+    out = (acc >= 0) ? ((acc + ((int32_t)dec->taps / 2)) / dec->taps) :
+          -((((int32_t)dec->taps / 2) - acc) / dec->taps);
+  }
+
+  if (out > 32767)
+  {
+    out = 32767;
+  }
+
+  else if (out < -32768)
+  {
+    out = -32768;
+  }
+
+  else
+  {
+    /* in range */
+  }
+
+  return (int16_t)out;
+}
+
+/**
+  * @brief  Decimate a block in place. The filter is evaluated only at
+  *         the output instants (one every factor inputs), the state
+  *         carries over between blocks.
+  *         The Q15 accumulator does not overflow as long as the sum of
+  *         the absolute taps is below 2.0.
+  *
+  * @param  dec      decimator object
+  * @param  xyz      interleaved samples, overwritten with the output
+  * @param  count    number of input samples
+  * @retval          number of output samples
+  *
+  */
+uint8_t lis3de_decim_run(lis3de_decim_t *dec, int16_t *xyz, uint8_t count)
+{
+  uint16_t in;
+  uint16_t out = 0U;
+  uint8_t axis;
+
+  for (in = 0U; in < count; in++)
+  {
+    for (axis = 0U; axis < 3U; axis++)
+    {
+      dec->hist[axis][dec->pos] = xyz[(in * 3U) + axis];
+    }
+
+    dec->pos = ((dec->pos + 1U) == dec->taps) ? 0U : (dec->pos + 1U);
+    dec->phase++;
+
+    if (dec->phase == dec->factor)
+    {
+      dec->phase = 0U;
+
+      /* output index never passes the input one */
+      for (axis = 0U; axis < 3U; axis++)
+      {
+        xyz[(out * 3U) + axis] = lis3de_decim_out(dec, axis);
+      }
+
+      out++;
+    }
+  }
+
+  return (uint8_t)out;
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup  LIS3DE_Features
+  * @brief     This section group the functions of the integer feature
+  *            engine: per axis mean, RMS, peak-to-peak, crest factor and
+  *            zero crossings accumulated sample by sample from the
+  *            interleaved (X, Y, Z) blocks of a FIFO drain, so a window
+  *            is never stored.
+  *            With lis3de_high_pass_on_outputs_set enabled the mean is
+  *            close to 0 and rms is the vibration level; without it rms
+  *            includes gravity, the AC part being
+  *            sqrt(rms^2 - mean^2).
+  * @{
+  *
+  */
+
+/**
+  * @brief  Start a new window, zero crossings are counted about the
+  *         mean of the previous one.
+  *
+  * @param  fe       feature engine
+  *
+  */
+static void lis3de_feat_clear(lis3de_feat_engine_t *fe)
+{
+  uint8_t axis;
+
+  fe->n = 0U;
+
+  for (axis = 0U; axis < 3U; axis++)
+  {
+    fe->sum[axis] = 0;
+    fe->sumsq[axis] = 0U;
+    fe->min[axis] = 32767;
+    fe->max[axis] = -32768;
+    fe->zc[axis] = 0U;
+    fe->sign[axis] = 0;
+  }
+}
+
+/**
+  * @brief  Feature engine initialization.
+  *
+  * @param  fe       feature engine
+  * @param  window   samples per window, 1 .. 65535
+  * @retval          0 -> no Error, -1 -> invalid arguments
+  *
+  */
+int32_t lis3de_feat_init(lis3de_feat_engine_t *fe, uint16_t window)
+{
+  uint8_t axis;
+  int32_t ret = 0;
+
+  if (window == 0U)
+  {
+    ret = -1;
+  }
+
+  else
+  {
+    fe->window = window;
+
+    for (axis = 0U; axis < 3U; axis++)
+    {
+      fe->bias[axis] = 0;
+    }
+
+    lis3de_feat_clear(fe);
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Integer square root, rounded down.
+  *
+  * @param  val      radicand
+  * @retval          floor(sqrt(val))
+  *
+  */
+static uint32_t lis3de_isqrt(uint64_t val)
+{
+  uint64_t bit = (uint64_t)1U << 62;
+  uint64_t res = 0U;
+
+  while (bit > val)
+  {
+    bit >>= 2;
+  }
+
+  while (bit != 0U)
+  {
+    if (val >= (res + bit))
+    {
+      val -= res + bit;
+      res = (res >> 1) + bit;
+    }
+
+    else
+    {
+      res >>= 1;
+    }
+
+    bit >>= 2;
+  }
+
+  return (uint32_t)res;
+}
+
+/**
+  * @brief  Features of the completed window.
+  *
+  * @param  fe       feature engine
+  * @param  out      features
+  *
+  */
+static void lis3de_feat_close(lis3de_feat_engine_t *fe, lis3de_feat_t *out)
+{
+  lis3de_feat_axis_t *feat;
+  int32_t half = (int32_t)fe->n / 2;
+  int32_t peak;
+  uint32_t crest;
+  uint32_t rms;
+  uint8_t axis;
+
+  out->count = fe->n;
+
+  for (axis = 0U; axis < 3U; axis++)
+  {
+    feat = &out->axis[axis];
+
+    feat->mean = (int16_t)((fe->sum[axis] >= 0) ?
+                           ((fe->sum[axis] + half) / (int32_t)fe->n) :
+                           -((half - fe->sum[axis]) / (int32_t)fe->n));
+
+    /* 32767 at most as |x| <= 32768 */
+    rms = lis3de_isqrt((fe->sumsq[axis] + (uint64_t)half) / fe->n);
+    feat->rms = (uint16_t)rms;
+    feat->p2p = (uint16_t)((int32_t)fe->max[axis] - fe->min[axis]);
+
+    peak = ((int32_t)fe->max[axis] > -(int32_t)fe->min[axis]) ?
+           (int32_t)fe->max[axis] : -(int32_t)fe->min[axis];
+    crest = (rms == 0U) ? 0U :
+            ((((uint32_t)peak << 8) + (rms / 2U)) / rms);
+    /* sqrt(n) for a single spike: saturates past 65536 samples */
+    feat->crest = (crest > UINT16_MAX) ? UINT16_MAX : (uint16_t)crest;
+    feat->zc = fe->zc[axis];
+
+    fe->bias[axis] = feat->mean;
+  }
+
+  lis3de_feat_clear(fe);
+}
+
+/**
+  * @brief  Accumulate a block, typically right after the drain that
+  *         filled it while the samples are still in cache. The state
+  *         carries over between blocks.
+  *
+  * @param  fe       feature engine
+  * @param  xyz      interleaved samples
+  * @param  count    number of samples
+  * @param  out      features of the windows completed by the block
+  * @param  max      capacity of out, further windows are dropped
+  * @retval          number of features written in out
+  *
+  */
+uint8_t lis3de_feat_run(lis3de_feat_engine_t *fe, const int16_t *xyz,
+                        uint8_t count, lis3de_feat_t *out, uint8_t max)
+{
+  uint16_t in;
+  uint8_t num = 0U;
+  uint8_t axis;
+  int32_t val;
+  int8_t sign;
+
+  for (in = 0U; in < count; in++)
+  {
+    for (axis = 0U; axis < 3U; axis++)
+    {
+      val = xyz[(in * 3U) + axis];
+
+      fe->sum[axis] += val;
+      fe->sumsq[axis] += (uint64_t)(val * val);
+
+      if (val < fe->min[axis])
+      {
+        fe->min[axis] = (int16_t)val;
+      }
+
+      if (val > fe->max[axis])
+      {
+        fe->max[axis] = (int16_t)val;
+      }
+
+      val -= fe->bias[axis];
+      sign = (val > 0) ? 1 : ((val < 0) ? -1 : 0);
+
+      if (sign != 0)
+      {
+        if ((fe->sign[axis] != 0) && (sign != fe->sign[axis]))
+        {
+          fe->zc[axis]++;
+        }
+
+        fe->sign[axis] = sign;
+      }
+    }
+
+    fe->n++;
+
+    if (fe->n == fe->window)
+    {
+      if (num < max)
+      {
+        lis3de_feat_close(fe, &out[num]);
+        num++;
+      }
+
+      else
+      {
+        lis3de_feat_clear(fe);
+      }
+    }
+  }
+
+  return num;
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup  LIS3DE_Packed
+  * @brief     This section group the functions of the packed block
+  *            format: a LIS3DE_PACK_HDR_SIZE bytes little endian header
+  *            (ODR / full scale / codec, count, sequence, timestamp,
+  *            payload length) then the samples, either 3 bytes each
+  *            (raw) or per-axis deltas as zigzag varints of 4-bit
+  *            groups (delta), 1.5 bytes per sample on a quiet signal.
+  * @{
+  *
+  */
+
+/**
+  * @brief  Saturate a sample to the 8-bit output range.
+  *
+  * @param  val      sample
+  * @retval          8-bit sample
+  *
+  */
+static int8_t lis3de_pack_s8(int16_t val)
+{
+  int16_t out = val;
+
+  if (out > 127)
+  {
+    out = 127;
+  }
+
+  else if (out < -128)
+  {
+    out = -128;
+  }
+
+  else
+  {
+    /* in range */
+  }
+
+  return (int8_t)out;
+}
+
+/**
+  * @brief  Delta encoding of a block, stops as soon as it is not
+  *         smaller than the raw one. Each delta (the first sample from
+  *         0) is zigzag mapped, then written as a varint of 4-bit
+  *         groups: 3 value bits and a continuation bit.
+  *
+  * @param  xyz      interleaved samples
+  * @param  count    number of samples
+  * @param  out      payload buffer, 3 * count bytes
+  * @retval          payload length, 0 if raw is smaller
+  *
+  */
+static uint16_t lis3de_pack_delta(const int16_t *xyz, uint8_t count,
+                                  uint8_t *out)
+{
+  uint16_t size = (uint16_t)count * 3U;
+  uint16_t nib = 0U;
+  uint16_t zz;
+  uint16_t i;
+  uint8_t group;
+  int16_t prev = 0;
+  int16_t d;
+
+  for (i = 0U; (i < size) && (nib < (size * 2U)); i++)
+  {
+    if (i >= 3U)
+    {
+      prev = lis3de_pack_s8(xyz[i - 3U]);
+    }
+
+    d = (int16_t)(lis3de_pack_s8(xyz[i]) - prev);
+    zz = (d >= 0) ? (uint16_t)((uint16_t)d * 2U) :
+         (uint16_t)(((uint16_t)(-d) * 2U) - 1U);
+
+    do
+    {
+      group = (uint8_t)(zz & 0x07U);
+      zz >>= 3;
+
+      if (zz != 0U)
+      {
+        group |= 0x08U;
+      }
+
+      if (nib < (size * 2U))
+      {
+        if ((nib & 1U) == 0U)
+        {
+          out[nib / 2U] = group;
+        }
+
+        else
+        {
+          out[nib / 2U] |= (uint8_t)(group << 4);
+        }
+      }
+
+      nib++;
+    } while (zz != 0U);
+  }
+
+  nib = (nib + 1U) / 2U;
+
+  return (nib < size) ? nib : 0U;
+}
+
+/**
+  * @brief  Encode a block.
+  *
+  * @param  hdr      block header; codec is the requested one, count the
+  *                  number of samples. codec and len are updated with
+  *                  the values written (delta falls back to raw when
+  *                  it does not save space)
+  * @param  xyz      interleaved samples, saturated to 8 bit
+  * @param  buf      output buffer
+  * @param  size     output buffer size, at least
+  *                  LIS3DE_PACK_HDR_SIZE + 3 * count
+  * @retval          0 -> no Error, -1 -> buffer too small
+  *
+  */
+int32_t lis3de_pack_encode(lis3de_pack_hdr_t *hdr, const int16_t *xyz,
+                           uint8_t *buf, uint16_t size)
+{
+  uint8_t *payload = &buf[LIS3DE_PACK_HDR_SIZE];
+  uint16_t i;
+  int32_t ret = 0;
+
+  if (size < (LIS3DE_PACK_HDR_SIZE + ((uint16_t)hdr->count * 3U)))
+  {
+    ret = -1;
+  }
+
+  else
+  {
+    hdr->len = 0U;
+
+    if (hdr->codec == LIS3DE_PACK_DELTA)
+    {
+      hdr->len = lis3de_pack_delta(xyz, hdr->count, payload);
+    }
+
+    if (hdr->len == 0U)
+    {
+      hdr->codec = LIS3DE_PACK_RAW;
+      hdr->len = (uint16_t)hdr->count * 3U;
+
+      for (i = 0U; i < hdr->len; i++)
+      {
+        payload[i] = (uint8_t)lis3de_pack_s8(xyz[i]);
+      }
+    }
+
+    buf[0] = (uint8_t)(((uint8_t)hdr->odr & 0x0FU) |
+                       (((uint8_t)hdr->fs & 0x03U) << 4) |
+                       (((uint8_t)hdr->codec & 0x03U) << 6));
+    buf[1] = hdr->count;
+    buf[2] = (uint8_t)hdr->seq;
+    buf[3] = (uint8_t)(hdr->seq >> 8);
+    buf[4] = (uint8_t)hdr->timestamp;
+    buf[5] = (uint8_t)(hdr->timestamp >> 8);
+    buf[6] = (uint8_t)(hdr->timestamp >> 16);
+    buf[7] = (uint8_t)(hdr->timestamp >> 24);
+    buf[8] = (uint8_t)hdr->len;
+    buf[9] = (uint8_t)(hdr->len >> 8);
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Open a packed block without copying it: the header is
+  *         decoded and the samples are then read in place with
+  *         lis3de_pack_next. For raw blocks view->payload can also be
+  *         indexed directly, 3 bytes per sample.
+  *
+  * @param  view     block view
+  * @param  buf      packed block, kept referenced by the view
+  * @param  len      bytes available in buf
+  * @retval          0 -> no Error, -1 -> truncated or invalid block
+  *
+  */
+int32_t lis3de_pack_view(lis3de_pack_view_t *view, const uint8_t *buf,
+                         uint16_t len)
+{
+  lis3de_pack_hdr_t *hdr = &view->hdr;
+  int32_t ret = 0;
+
+  if (len < LIS3DE_PACK_HDR_SIZE)
+  {
+    ret = -1;
+  }
+
+  else
+  {
+    hdr->odr = (lis3de_odr_t)(buf[0] & 0x0FU);
+    hdr->fs = (lis3de_fs_t)((buf[0] >> 4) & 0x03U);
+    hdr->codec = (lis3de_pack_codec_t)((buf[0] >> 6) & 0x03U);
+    hdr->count = buf[1];
+    hdr->seq = (uint16_t)buf[2] | ((uint16_t)buf[3] << 8);
+    hdr->timestamp = (uint32_t)buf[4] | ((uint32_t)buf[5] << 8) |
+                     ((uint32_t)buf[6] << 16) | ((uint32_t)buf[7] << 24);
+    hdr->len = (uint16_t)buf[8] | ((uint16_t)buf[9] << 8);
+    view->payload = &buf[LIS3DE_PACK_HDR_SIZE];
+    view->pos = 0U;
+    view->idx = 0U;
+    view->prev[0] = 0;
+    view->prev[1] = 0;
+    view->prev[2] = 0;
+
+    if ((hdr->len > (len - LIS3DE_PACK_HDR_SIZE)) ||
+        (hdr->codec > LIS3DE_PACK_DELTA) ||
+        ((hdr->codec == LIS3DE_PACK_RAW) &&
+         (hdr->len != ((uint16_t)hdr->count * 3U))))
+    {
+      ret = -1;
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Next sample of a block view.
+  *
+  * @param  view     block view opened by lis3de_pack_view
+  * @param  xyz      X, Y, Z of the sample
+  * @retval          0 -> no Error, -1 -> end of block or corrupted
+  *
+  */
+int32_t lis3de_pack_next(lis3de_pack_view_t *view, int16_t *xyz)
+{
+  const uint8_t *payload = view->payload;
+  uint16_t zz;
+  uint8_t group;
+  uint8_t shift;
+  uint8_t axis;
+  int32_t ret = 0;
+
+  if (view->idx >= view->hdr.count)
+  {
+    ret = -1;
+  }
+
+  for (axis = 0U; (axis < 3U) && (ret == 0); axis++)
+  {
+    if (view->hdr.codec == LIS3DE_PACK_RAW)
+    {
+      view->prev[axis] = (int8_t)payload[view->pos];
+      view->pos++;
+    }
+
+    else
+    {
+      /* pos counts 4-bit groups */
+      zz = 0U;
+      shift = 0U;
+      group = 0x08U;
+
+      while (((group & 0x08U) != 0U) && (ret == 0))
+      {
+        if ((view->pos >= (view->hdr.len * 2U)) || (shift > 6U))
+        {
+          ret = -1;
+        }
+
+        else
+        {
+          group = payload[view->pos / 2U];
+          group = ((view->pos & 1U) == 0U) ? (group & 0x0FU) :
+                  (uint8_t)(group >> 4);
+          zz |= (uint16_t)((uint16_t)(group & 0x07U) << shift);
+          shift += 3U;
+          view->pos++;
+        }
+      }
+
+      view->prev[axis] = (int16_t)(view->prev[axis] +
+                                   (((zz & 1U) == 0U) ?
+                                    (int16_t)(zz >> 1) :
+                                    -(int16_t)((zz + 1U) >> 1)));
+    }
+
+    xyz[axis] = view->prev[axis];
+  }
+
+  if (ret == 0)
+  {
+    view->idx++;
+  }
+
+  return ret;
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup  LIS3DE_Timestamp
+  * @brief     This section group the functions that timestamp the
+  *            samples of FIFO batches. Each watermark event pairs the
+  *            interrupt tick with the index of the newest sample in the
+  *            FIFO; an exponentially weighted least squares line through
+  *            these pairs gives the actual sample period and phase. The
+  *            fit is updated once per batch and kept centred on the last
+  *            event, so float_t precision does not degrade with time.
+  * @{
+  *
+  */
+
+/**
+  * @brief  Round to the nearest integer.
+  *
+  * @param  val      value
+  * @retval          rounded value
+  *
+  */
+static int32_t lis3de_ts_round(float_t val)
+{
+  return (val >= 0.0f) ? (int32_t)(val + 0.5f) : -(int32_t)(0.5f - val);
+}
+
+/**
+  * @brief  Timestamping initialization.
+  *
+  * @param  ts       timestamping object
+  * @param  nominal  nominal sample period (1 / ODR) in tick units
+  * @param  lambda   forgetting factor of the fit, (0, 1], e.g. 0.95
+  * @retval          0 -> no Error, -1 -> invalid arguments
+  *
+  */
+int32_t lis3de_ts_init(lis3de_ts_t *ts, float_t nominal, float_t lambda)
+{
+  int32_t ret = 0;
+
+  if ((nominal <= 0.0f) || (lambda <= 0.0f) || (lambda > 1.0f))
+  {
+    ret = -1;
+  }
+
+  else
+  {
+    ts->nominal = nominal;
+    ts->lambda = lambda;
+    ts->period = nominal;
+    ts->w = 0.0f;
+    ts->mx = 0.0f;
+    ts->my = 0.0f;
+    ts->sxx = 0.0f;
+    ts->sxy = 0.0f;
+    ts->t_org = 0U;
+    ts->k_org = 0U;
+    ts->index = 0U;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Account a watermark event and timestamp the batch drained
+  *         for it, O(1) whatever the batch size.
+  *
+  * @param  ts       timestamping object
+  * @param  t_irq    tick of the watermark interrupt
+  * @param  level    FIFO level at the interrupt, e.g. from
+  *                  lis3de_fifo_data_level_get in the ISR
+  * @param  count    number of samples drained
+  * @param  batch    timestamp of the first sample and period
+  *
+  */
+void lis3de_ts_batch(lis3de_ts_t *ts, uint32_t t_irq, uint8_t level,
+                     uint8_t count, lis3de_ts_batch_t *batch)
+{
+  uint32_t k = ts->index + level - 1U;
+  float_t dx;
+  float_t dy;
+  float_t b;
+
+  if (level == 0U)
+  {
+    k = ts->index;
+  }
+
+  /* move the origin to the new event, covariances do not change */
+  ts->mx -= (float_t)(int32_t)(k - ts->k_org);
+  ts->my -= (float_t)(int32_t)(t_irq - ts->t_org);
+  ts->k_org = k;
+  ts->t_org = t_irq;
+
+  /* weighted Welford update with the new point at (0, 0) */
+  ts->w = (ts->lambda * ts->w) + 1.0f;
+  dx = -ts->mx;
+  dy = -ts->my;
+  ts->mx += dx / ts->w;
+  ts->my += dy / ts->w;
+  ts->sxx = (ts->lambda * ts->sxx) + (dx * -ts->mx);
+  ts->sxy = (ts->lambda * ts->sxy) + (dx * -ts->my);
+
+  if (ts->sxx > 0.0f)
+  {
+    b = ts->sxy / ts->sxx;
+
+    /* keep the nominal period until the fit is meaningful */
+    if ((b > (ts->nominal * 0.8f)) && (b < (ts->nominal * 1.2f)))
+    {
+      ts->period = b;
+    }
+  }
+
+  batch->period = ts->period;
+  batch->count = count;
+  /* line through the weighted means, evaluated at the first sample */
+  batch->t0 = ts->t_org +
+              (uint32_t)lis3de_ts_round(ts->my - (ts->period * ts->mx) +
+                                        (ts->period *
+                                         (float_t)(int32_t)(ts->index - k)));
+  ts->index += count;
+}
+
+/**
+  * @brief  Timestamp of a sample of a batch.
+  *
+  * @param  batch    batch timestamps
+  * @param  idx      sample index in the batch
+  * @retval          tick of the sample
+  *
+  */
+uint32_t lis3de_ts_sample(const lis3de_ts_batch_t *batch, uint8_t idx)
+{
+  return batch->t0 + (uint32_t)lis3de_ts_round(batch->period * (float_t)idx);
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup  LIS3DE_Tap_generator
+  * @brief     This section group all the functions that manage the tap and
+  *            double tap event generation
+  * @{
+  *
+  */
+
+/**
+  * @brief  Tap/Double Tap generator configuration register.[set]
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      registers CLICK_CFG
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lis3de_tap_conf_set(const stmdev_ctx_t *ctx,
+                            lis3de_click_cfg_t *val)
+{
+  int32_t ret;
+
+  ret = lis3de_write_reg(ctx, LIS3DE_CLICK_CFG, (uint8_t *) val, 1);
+
+  return ret;
+}
+
+/**
+  * @brief  Tap/Double Tap generator configuration register.[get]
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      registers CLICK_CFG
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lis3de_tap_conf_get(const stmdev_ctx_t *ctx,
+                            lis3de_click_cfg_t *val)
+{
+  int32_t ret;
+
+  ret = lis3de_read_reg(ctx, LIS3DE_CLICK_CFG, (uint8_t *) val, 1);
+
+  return ret;
+}
+/**
+  * @brief  Tap/Double Tap generator source register.[get]
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      registers CLICK_SRC
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lis3de_tap_source_get(const stmdev_ctx_t *ctx,
+                              lis3de_click_src_t *val)
+{
+  int32_t ret;
+
+  ret = lis3de_read_reg(ctx, LIS3DE_CLICK_SRC, (uint8_t *) val, 1);
+
+  return ret;
+}
+/**
+  * @brief  User-defined threshold value for Tap/Double Tap event.[set]
+  *         1 LSB = full scale/128
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      change the values of ths in reg CLICK_THS
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lis3de_tap_threshold_set(const stmdev_ctx_t *ctx, uint8_t val)
+{
+  lis3de_click_ths_t click_ths;
+  int32_t ret;
+
+  lis3de_lock(ctx);
+
+  ret = lis3de_read_reg(ctx, LIS3DE_CLICK_THS, (uint8_t *)&click_ths, 1);
+
+  if (ret == 0)
+  {
+    click_ths.ths = val;
+    ret = lis3de_write_reg(ctx, LIS3DE_CLICK_THS, (uint8_t *)&click_ths, 1);
+  }
+
+  lis3de_unlock(ctx);
+
+  return ret;
+}
+
+/**
+  * @brief  User-defined threshold value for Tap/Double Tap event.[get]
+  *         1 LSB = full scale/128
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      change the values of ths in reg CLICK_THS
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lis3de_tap_threshold_get(const stmdev_ctx_t *ctx, uint8_t *val)
+{
+  lis3de_click_ths_t click_ths;
+  int32_t ret;
+
+  ret = lis3de_read_reg(ctx, LIS3DE_CLICK_THS, (uint8_t *)&click_ths, 1);
+  *val = (uint8_t)click_ths.ths;
+
+  return ret;
+}
+
+/**
+  * @brief   If the LIR_Click bit is not set, the interrupt is kept high
+  *          for the duration of the latency window.
+  *          If the LIR_Click bit is set, the interrupt is kept high until the
+  *          CLICK_SRC(39h) register is read.[set]
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      change the values of lir in reg CLICK_THS
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lis3de_tap_notification_mode_set(const stmdev_ctx_t *ctx,
+                                         lis3de_lir_t val)
+{
+  lis3de_click_ths_t click_ths;
+  int32_t ret;
+
+  lis3de_lock(ctx);
+
+  ret = lis3de_read_reg(ctx, LIS3DE_CLICK_THS, (uint8_t *)&click_ths, 1);
+
+  if (ret == 0)
+  {
+    click_ths.lir = (uint8_t)val;
+    ret = lis3de_write_reg(ctx, LIS3DE_CLICK_THS, (uint8_t *)&click_ths, 1);
+  }
+
+  lis3de_unlock(ctx);
+
+  return ret;
+}
+
+/**
+  * @brief   If the LIR_Click bit is not set, the interrupt is kept high
+  *          for the duration of the latency window.
+  *          If the LIR_Click bit is set, the interrupt is kept high until the
+  *          CLICK_SRC(39h) register is read.[get]
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      Get the values of lir in reg CLICK_THS
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lis3de_tap_notification_mode_get(const stmdev_ctx_t *ctx,
+                                         lis3de_lir_t *val)
+{
+  lis3de_click_ths_t click_ths;
+  int32_t ret;
+
+  ret = lis3de_read_reg(ctx, LIS3DE_CLICK_THS, (uint8_t *)&click_ths, 1);
+
+  switch (click_ths.lir)
+  {
+    case LIS3DE_TAP_PULSED:
+      *val = LIS3DE_TAP_PULSED;
+      break;
+
+    case LIS3DE_TAP_LATCHED:
+      *val = LIS3DE_TAP_LATCHED;
+      break;
+
+    default:
+      *val = LIS3DE_TAP_PULSED;
+      break;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  The maximum time (1 LSB = 1/ODR) interval that can elapse
+  *         between the start of the click-detection procedure and when the
+  *         acceleration falls back below the threshold.[set]
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      change the values of tli in reg TIME_LIMIT
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lis3de_shock_dur_set(const stmdev_ctx_t *ctx, uint8_t val)
+{
+  lis3de_time_limit_t time_limit;
+  int32_t ret;
+
+  lis3de_lock(ctx);
+
+  ret = lis3de_read_reg(ctx, LIS3DE_TIME_LIMIT, (uint8_t *)&time_limit, 1);
+
+  if (ret == 0)
+  {
+    time_limit.tli = val;
+    ret = lis3de_write_reg(ctx, LIS3DE_TIME_LIMIT, (uint8_t *)&time_limit, 1);
+  }
+
+  lis3de_unlock(ctx);
+
+  return ret;
+}
+
+/**
+  * @brief  The maximum time (1 LSB = 1/ODR) interval that can elapse between
+  *         the start of the click-detection procedure and when the
+  *         acceleration falls back below the threshold.[get]
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      change the values of tli in reg TIME_LIMIT
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lis3de_shock_dur_get(const stmdev_ctx_t *ctx, uint8_t *val)
+{
+  lis3de_time_limit_t time_limit;
+  int32_t ret;
+
+  ret = lis3de_read_reg(ctx, LIS3DE_TIME_LIMIT, (uint8_t *)&time_limit, 1);
+  *val = (uint8_t)time_limit.tli;
+
+  return ret;
+}
+
+/**
+  * @brief  The time (1 LSB = 1/ODR) interval that starts after the first
+  *         click detection where the click-detection procedure is
+  *         disabled, in cases where the device is configured for
+  *         double-click detection.[set]
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      change the values of tla in reg TIME_LATENCY
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lis3de_quiet_dur_set(const stmdev_ctx_t *ctx, uint8_t val)
+{
+  lis3de_time_latency_t time_latency;
+  int32_t ret;
+
+  lis3de_lock(ctx);
+
+  ret = lis3de_read_reg(ctx, LIS3DE_TIME_LATENCY,
+                        (uint8_t *)&time_latency, 1);
+
+  if (ret == 0)
+  {
+    time_latency.tla = val;
+    ret = lis3de_write_reg(ctx, LIS3DE_TIME_LATENCY,
+                           (uint8_t *)&time_latency, 1);
+  }
+
+  lis3de_unlock(ctx);
+
+  return ret;
+}
+
+/**
+  * @brief  The time (1 LSB = 1/ODR) interval that starts after the first
+  *         click detection where the click-detection procedure is
+  *         disabled, in cases where the device is configured for
+  *         double-click detection.[get]
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      change the values of tla in reg TIME_LATENCY
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lis3de_quiet_dur_get(const stmdev_ctx_t *ctx, uint8_t *val)
+{
+  lis3de_time_latency_t time_latency;
+  int32_t ret;
+
+  ret = lis3de_read_reg(ctx, LIS3DE_TIME_LATENCY,
+                        (uint8_t *)&time_latency, 1);
+  *val = (uint8_t)time_latency.tla;
+
+  return ret;
+}
+
+/**
+  * @brief  The maximum interval of time (1 LSB = 1/ODR) that can elapse
+  *         after the end of the latency interval in which the click-detection
+  *         procedure can start, in cases where the device is configured
+  *         for double-click detection.[set]
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      change the values of tw in reg TIME_WINDOW
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lis3de_double_tap_timeout_set(const stmdev_ctx_t *ctx, uint8_t val)
+{
+  lis3de_time_window_t time_window;
+  int32_t ret;
+
+  lis3de_lock(ctx);
+
+  ret = lis3de_read_reg(ctx, LIS3DE_TIME_WINDOW,
+                        (uint8_t *)&time_window, 1);
+
+  if (ret == 0)
+  {
+    time_window.tw = val;
+    ret = lis3de_write_reg(ctx, LIS3DE_TIME_WINDOW,
+                           (uint8_t *)&time_window, 1);
+  }
+
+  lis3de_unlock(ctx);
+
+  return ret;
+}
+
+/**
+  * @brief  The maximum interval of time (1 LSB = 1/ODR) that can elapse
+  *         after the end of the latency interval in which the
+  *         click-detection procedure can start, in cases where the device
+  *         is configured for double-click detection.[get]
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      change the values of tw in reg TIME_WINDOW
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lis3de_double_tap_timeout_get(const stmdev_ctx_t *ctx, uint8_t *val)
+{
+  lis3de_time_window_t time_window;
+  int32_t ret;
+
+  ret = lis3de_read_reg(ctx, LIS3DE_TIME_WINDOW,
+                        (uint8_t *)&time_window, 1);
+  *val = (uint8_t)time_window.tw;
+
+  return ret;
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup  LIS3DE_Activity_inactivity
+  * @brief     This section group all the functions concerning activity
+  *            inactivity functionality
+  * @{
+  *
+  */
+
+/**
+  * @brief    Sleep-to-wake, return-to-sleep activation threshold in
+  *           low-power mode.[set]
+  *           1 LSb = 16mg@2g / 32mg@4g / 62mg@8g / 186mg@16g
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      change the values of acth in reg ACT_THS
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lis3de_act_threshold_set(const stmdev_ctx_t *ctx, uint8_t val)
+{
+  lis3de_act_ths_t act_ths;
+  int32_t ret;
+
+  lis3de_lock(ctx);
+
+  ret = lis3de_read_reg(ctx, LIS3DE_ACT_THS, (uint8_t *)&act_ths, 1);
+
+  if (ret == 0)
+  {
+    act_ths.acth = val;
+    ret = lis3de_write_reg(ctx, LIS3DE_ACT_THS, (uint8_t *)&act_ths, 1);
+  }
+
+  lis3de_unlock(ctx);
+
+  return ret;
+}
+
+/**
+  * @brief  Sleep-to-wake, return-to-sleep activation threshold in low-power
+  *         mode.[get]
+  *         1 LSb = 16mg@2g / 32mg@4g / 62mg@8g / 186mg@16g
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      change the values of acth in reg ACT_THS
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lis3de_act_threshold_get(const stmdev_ctx_t *ctx, uint8_t *val)
+{
+  lis3de_act_ths_t act_ths;
+  int32_t ret;
+
+  ret = lis3de_read_reg(ctx, LIS3DE_ACT_THS, (uint8_t *)&act_ths, 1);
+  *val = (uint8_t)act_ths.acth;
+
+  return ret;
+}
+
+/**
+  * @brief  Sleep-to-wake, return-to-sleep.[set]
+  *         duration = (8*1[LSb]+1)/ODR
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      change the values of actd in reg ACT_DUR
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lis3de_act_timeout_set(const stmdev_ctx_t *ctx, uint8_t val)
+{
+  lis3de_act_dur_t act_dur;
+  int32_t ret;
+
+  lis3de_lock(ctx);
+
+  ret = lis3de_read_reg(ctx, LIS3DE_ACT_DUR, (uint8_t *)&act_dur, 1);
+
+  if (ret == 0)
+  {
+    act_dur.actd = val;
+    ret = lis3de_write_reg(ctx, LIS3DE_ACT_DUR, (uint8_t *)&act_dur, 1);
+  }
+
+  lis3de_unlock(ctx);
+
+  return ret;
+}
+
+/**
+  * @brief  Sleep-to-wake, return-to-sleep.[get]
+  *         duration = (8*1[LSb]+1)/ODR
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      change the values of actd in reg ACT_DUR
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lis3de_act_timeout_get(const stmdev_ctx_t *ctx, uint8_t *val)
+{
+  lis3de_act_dur_t act_dur;
+  int32_t ret;
+
+  ret = lis3de_read_reg(ctx, LIS3DE_ACT_DUR, (uint8_t *)&act_dur, 1);
+  *val = (uint8_t)act_dur.actd;
+
+  return ret;
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup  LIS3DE_Governor
+  * @brief     This section group the functions that switch ODR, power
+  *            and FIFO mode from a policy table, driven by the activity
+  *            / inactivity events. Activity ramps straight to the top
+  *            level; inactivity steps down one level at a time, each
+  *            level being held at least its dwell time (hysteresis).
+  * @{
+  *
+  */
+
+/**
+  * @brief  Write the configuration of a policy level, in one staged
+  *         transaction when the context has a shadow cache.
+  *
+  * @param  gov      governor object
+  * @param  level    policy table index
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+static int32_t lis3de_gov_apply(lis3de_gov_t *gov, uint8_t level)
+{
+  const lis3de_gov_level_t *cfg = &gov->policy[level];
+  uint8_t staged;
+  int32_t ret;
+
+  /* samples at the old and new ODR must not share the FIFO */
+  ret = lis3de_fifo_mode_set(gov->ctx, LIS3DE_BYPASS_MODE);
+  staged = (lis3de_cfg_begin(gov->ctx) == 0) ? 1U : 0U;
+
+  if (ret == 0)
+  {
+    ret = lis3de_data_rate_set(gov->ctx, cfg->odr);
+  }
+
+  if (ret == 0)
+  {
+    ret = lis3de_operating_mode_set(gov->ctx, cfg->op_md);
+  }
+
+  if (ret == 0)
+  {
+    /* sleep time is counted in ODR periods: rescaled per level */
+    ret = lis3de_act_timeout_set(gov->ctx, cfg->act_dur);
+  }
+
+  if (ret == 0)
+  {
+    ret = lis3de_fifo_watermark_set(gov->ctx, cfg->wtm);
+  }
+
+  if (ret == 0)
+  {
+    ret = lis3de_fifo_mode_set(gov->ctx, cfg->fifo_md);
+  }
+
+  if (staged == 1U)
+  {
+    if (ret == 0)
+    {
+      ret = lis3de_cfg_commit(gov->ctx);
+    }
+
+    else
+    {
+      (void)lis3de_cfg_abort(gov->ctx);
+    }
+  }
+
+  if (ret == 0)
+  {
+    gov->level = level;
+    gov->since = gov->tick();
+    gov->transitions++;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Governor initialization, the top policy level is applied.
+  *
+  * @param  gov      governor object
+  * @param  ctx      read / write interface definitions
+  * @param  policy   levels sorted from lowest power to full rate
+  * @param  num      number of levels
+  * @param  tick     time base of the dwell times
+  * @retval          interface status, -1 on invalid arguments
+  *
+  */
+int32_t lis3de_gov_init(lis3de_gov_t *gov, const stmdev_ctx_t *ctx,
+                        const lis3de_gov_level_t *policy, uint8_t num,
+                        lis3de_tick_ptr tick)
+{
+  int32_t ret;
+
+  if ((policy == NULL) || (num == 0U) || (tick == NULL))
+  {
+    ret = -1;
+  }
+
+  else
+  {
+    gov->ctx = ctx;
+    gov->policy = policy;
+    gov->num = num;
+    gov->tick = tick;
+    gov->idle = 0U;
+    gov->transitions = 0U;
+    ret = lis3de_gov_apply(gov, num - 1U);
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Activity detected (e.g. LIS3DE_EVT_WAKE): back to full rate.
+  *
+  * @param  gov      governor object
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lis3de_gov_activity(lis3de_gov_t *gov)
+{
+  int32_t ret = 0;
+
+  gov->idle = 0U;
+
+  if (gov->level != (gov->num - 1U))
+  {
+    ret = lis3de_gov_apply(gov, gov->num - 1U);
+  }
+
+  else
+  {
+    gov->since = gov->tick();
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Inactivity detected (e.g. LIS3DE_EVT_SLEEP): the levels are
+  *         stepped down by lis3de_gov_update.
+  *
+  * @param  gov      governor object
+  *
+  */
+void lis3de_gov_inactivity(lis3de_gov_t *gov)
+{
+  gov->idle = 1U;
+}
+
+/**
+  * @brief  To be called periodically: while idle, steps one level down
+  *         once the current one has been held for its dwell time.
+  *
+  * @param  gov      governor object
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lis3de_gov_update(lis3de_gov_t *gov)
+{
+  int32_t ret = 0;
+
+  if ((gov->idle == 1U) && (gov->level > 0U) &&
+      ((gov->tick() - gov->since) >= gov->policy[gov->level].dwell))
+  {
+    ret = lis3de_gov_apply(gov, gov->level - 1U);
+  }
+
+  return ret;
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup  LIS3DE_Wake_on_motion
+  * @brief     This section group the one-call wake-on-motion profile:
+  *            interrupt generator 1 on high-pass filtered data, routed
+  *            to INT1 and latched, at low power. The previous profile is
+  *            saved and written back on resume.
+  * @{
+  *
+  */
+
+/**
+  * @brief  INT1_THS value of a threshold, 7 bits, at least 1 LSB.
+  *
+  * @param  fs       full scale, CTRL_REG4 FS field
+  * @param  mg       threshold in mg
+  * @retval          threshold in LSB
+  *
+  */
+static uint8_t lis3de_wom_ths(uint8_t fs, uint16_t mg)
+{
+  uint32_t lsb;
+  uint32_t ths;
+
+  switch (fs)
+  {
+    case LIS3DE_2g:
+      lsb = 16U;
+      break;
+
+    case LIS3DE_4g:
+      lsb = 32U;
+      break;
+
+    case LIS3DE_8g:
+      lsb = 62U;
+      break;
+
+    default:
+      lsb = 186U;
+      break;
+  }
+
+  ths = ((uint32_t)mg + (lsb / 2U)) / lsb;
+  ths = (ths > 127U) ? 127U : ths;
+
+  return (ths == 0U) ? 1U : (uint8_t)ths;
+}
+
+/**
+  * @brief  INT1_DURATION value of a time, 7 bits of 1 / ODR.
+  *
+  * @param  odr      data rate, CTRL_REG1 ODR field
+  * @param  ms       duration in ms
+  * @retval          duration in ODR periods
+  *
+  */
+static uint8_t lis3de_wom_dur(uint8_t odr, uint16_t ms)
+{
+  uint32_t hz;
+  uint32_t dur;
+
+  switch (odr)
+  {
+    case LIS3DE_ODR_1Hz:
+      hz = 1U;
+      break;
+
+    case LIS3DE_ODR_10Hz:
+      hz = 10U;
+      break;
+
+    case LIS3DE_ODR_25Hz:
+      hz = 25U;
+      break;
+
+    case LIS3DE_ODR_50Hz:
+      hz = 50U;
+      break;
+
+    case LIS3DE_ODR_100Hz:
+      hz = 100U;
+      break;
+
+    case LIS3DE_ODR_200Hz:
+      hz = 200U;
+      break;
+
+    case LIS3DE_ODR_400Hz:
+      hz = 400U;
+      break;
+
+    case LIS3DE_ODR_1kHz6:
+      hz = 1600U;
+      break;
+
+    default:
+      /* low power */
+      hz = 5376U;
+      break;
+  }
+
+  dur = (((uint32_t)ms * hz) + 500U) / 1000U;
+
+  return (dur > 127U) ? 127U : (uint8_t)dur;
+}
+
+/**
+  * @brief  Wake-on-motion profile.[set]
+  *         The current profile is saved in wom (answered from RAM with a
+  *         valid shadow cache), then wake-up is set in the datasheet
+  *         order: CTRL_REG1 .. CTRL_REG5 in one burst (low power at the
+  *         current ODR, 10 Hz if powered down, HP filter on IA1, IA1 on
+  *         INT1, latched, FIFO off), INT1_THS / INT1_DURATION, REFERENCE
+  *         read to reset the filter, INT1_CFG (X, Y, Z high events, OR)
+  *         last, then INT1_SRC read to clear any stale latch.
+  *
+  * @param  ctx            read / write interface definitions
+  * @param  wom            saved profile
+  * @param  threshold_mg   wake-up threshold, scaled for the current FS
+  * @param  duration_ms    minimum event duration, scaled for the ODR
+  * @retval          interface status, -1 if wake-on-motion is already
+  *                  active (the saved profile is kept)
+  *
+  */
+int32_t lis3de_wom_enable(const stmdev_ctx_t *ctx, lis3de_wom_t *wom,
+                          uint16_t threshold_mg, uint16_t duration_ms)
+{
+  lis3de_ctrl_reg1_t ctrl_reg1;
+  lis3de_ctrl_reg2_t ctrl_reg2;
+  lis3de_ctrl_reg3_t ctrl_reg3;
+  lis3de_ctrl_reg4_t ctrl_reg4;
+  lis3de_ctrl_reg5_t ctrl_reg5;
+  lis3de_ig1_cfg_t ig1_cfg;
+  uint8_t ctrl[5];
+  uint8_t ths[2];
+  uint8_t dummy;
+  int32_t ret;
+
+  if (wom->active == PROPERTY_ENABLE)
+  {
+    return -1;
+  }
+
+  lis3de_lock(ctx);
+
+  ret = lis3de_read_regs(ctx, LIS3DE_CTRL_REG1, wom->ctrl, 5U);
+
+  if (ret == 0)
+  {
+    ret = lis3de_read_reg(ctx, LIS3DE_FIFO_CTRL_REG, &wom->fifo_ctrl, 1);
+  }
+
+  if (ret == 0)
+  {
+    ret = lis3de_read_reg(ctx, LIS3DE_IG1_CFG, &wom->ig1_cfg, 1);
+  }
+
+  if (ret == 0)
+  {
+    ret = lis3de_read_regs(ctx, LIS3DE_IG1_THS, wom->ig1_ths, 2U);
+  }
+
+  if (ret == 0)
+  {
+    *(uint8_t *)&ctrl_reg1 = wom->ctrl[0];
+    *(uint8_t *)&ctrl_reg4 = wom->ctrl[3];
+
+    if (ctrl_reg1.odr == (uint8_t)LIS3DE_POWER_DOWN)
+    {
+      ctrl_reg1.odr = (uint8_t)LIS3DE_ODR_10Hz;
+    }
+
+    ctrl_reg1.lpen = PROPERTY_ENABLE;
+    ctrl_reg1.xen = PROPERTY_ENABLE;
+    ctrl_reg1.yen = PROPERTY_ENABLE;
+    ctrl_reg1.zen = PROPERTY_ENABLE;
+
+    *(uint8_t *)&ctrl_reg2 = 0x00U;
+    ctrl_reg2.hp = (uint8_t)LIS3DE_ON_INT1_GEN;
+
+    *(uint8_t *)&ctrl_reg3 = 0x00U;
+    ctrl_reg3.int1_ig1 = PROPERTY_ENABLE;
+
+    *(uint8_t *)&ctrl_reg5 = wom->ctrl[4];
+    ctrl_reg5.fifo_en = PROPERTY_DISABLE;
+    ctrl_reg5.lir_ig1 = PROPERTY_ENABLE;
+    ctrl_reg5.d4d_ig1 = PROPERTY_DISABLE;
+
+    ctrl[0] = *(uint8_t *)&ctrl_reg1;
+    ctrl[1] = *(uint8_t *)&ctrl_reg2;
+    ctrl[2] = *(uint8_t *)&ctrl_reg3;
+    ctrl[3] = *(uint8_t *)&ctrl_reg4;
+    ctrl[4] = *(uint8_t *)&ctrl_reg5;
+
+    ths[0] = lis3de_wom_ths(ctrl_reg4.fs, threshold_mg);
+    ths[1] = lis3de_wom_dur(ctrl_reg1.odr, duration_ms);
+
+    *(uint8_t *)&ig1_cfg = 0x00U;
+    ig1_cfg.xhie = PROPERTY_ENABLE;
+    ig1_cfg.yhie = PROPERTY_ENABLE;
+    ig1_cfg.zhie = PROPERTY_ENABLE;
+
+    ret = lis3de_write_regs(ctx, LIS3DE_CTRL_REG1, ctrl, 5U);
+  }
+
+  if (ret == 0)
+  {
+    ret = lis3de_write_regs(ctx, LIS3DE_IG1_THS, ths, 2U);
+  }
+
+  if (ret == 0)
+  {
+    ret = lis3de_read_reg(ctx, LIS3DE_REFERENCE, &dummy, 1);
+  }
 
   if (ret == 0)
   {
-    time_limit.tli = val;
-    ret = lis3de_write_reg(ctx, LIS3DE_TIME_LIMIT, (uint8_t *)&time_limit, 1);
+    /* armed last, on filtered data */
+    ret = lis3de_write_reg(ctx, LIS3DE_IG1_CFG, (uint8_t *)&ig1_cfg, 1);
   }
 
-  return ret;
-}
+  if (ret == 0)
+  {
+    ret = lis3de_read_reg(ctx, LIS3DE_IG1_SOURCE, &dummy, 1);
+  }
 
-/**
-  * @brief  The maximum time (1 LSB = 1/ODR) interval that can elapse between
-  *         the start of the click-detection procedure and when the
-  *         acceleration falls back below the threshold.[get]
-  *
-  * @param  ctx      read / write interface definitions
-  * @param  val      change the values of tli in reg TIME_LIMIT
-  * @retval          interface status (MANDATORY: return 0 -> no Error)
-  *
-  */
-int32_t lis3de_shock_dur_get(const stmdev_ctx_t *ctx, uint8_t *val)
-{
-  lis3de_time_limit_t time_limit;
-  int32_t ret;
+  if (ret == 0)
+  {
+    wom->active = PROPERTY_ENABLE;
+  }
 
-  ret = lis3de_read_reg(ctx, LIS3DE_TIME_LIMIT, (uint8_t *)&time_limit, 1);
-  *val = (uint8_t)time_limit.tli;
+  lis3de_unlock(ctx);
 
   return ret;
 }
 
 /**
-  * @brief  The time (1 LSB = 1/ODR) interval that starts after the first
-  *         click detection where the click-detection procedure is
-  *         disabled, in cases where the device is configured for
-  *         double-click detection.[set]
+  * @brief  Wake-on-motion profile.[reset]
+  *         Writes back the profile saved by lis3de_wom_enable: FIFO
+  *         emptied through bypass, generator 1, CTRL_REG1 .. CTRL_REG5
+  *         in one burst, FIFO_CTRL_REG. The latched INT1 source is
+  *         cleared.
   *
   * @param  ctx      read / write interface definitions
-  * @param  val      change the values of tla in reg TIME_LATENCY
-  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  * @param  wom      profile saved by lis3de_wom_enable
+  * @retval          interface status, -1 if wake-on-motion is not active
   *
   */
-int32_t lis3de_quiet_dur_set(const stmdev_ctx_t *ctx, uint8_t val)
+int32_t lis3de_wom_disable(const stmdev_ctx_t *ctx, lis3de_wom_t *wom)
 {
-  lis3de_time_latency_t time_latency;
+  uint8_t fifo_ctrl = 0x00U;
+  uint8_t dummy;
   int32_t ret;
 
-  ret = lis3de_read_reg(ctx, LIS3DE_TIME_LATENCY,
-                        (uint8_t *)&time_latency, 1);
+  if (wom->active != PROPERTY_ENABLE)
+  {
+    return -1;
+  }
+
+  lis3de_lock(ctx);
+
+  ret = lis3de_write_reg(ctx, LIS3DE_FIFO_CTRL_REG, &fifo_ctrl, 1);
 
   if (ret == 0)
   {
-    time_latency.tla = val;
-    ret = lis3de_write_reg(ctx, LIS3DE_TIME_LATENCY,
-                           (uint8_t *)&time_latency, 1);
+    ret = lis3de_write_regs(ctx, LIS3DE_IG1_THS, wom->ig1_ths, 2U);
+  }
+
+  if (ret == 0)
+  {
+    ret = lis3de_write_reg(ctx, LIS3DE_IG1_CFG, &wom->ig1_cfg, 1);
+  }
+
+  if (ret == 0)
+  {
+    ret = lis3de_write_regs(ctx, LIS3DE_CTRL_REG1, wom->ctrl, 5U);
+  }
+
+  if (ret == 0)
+  {
+    ret = lis3de_write_reg(ctx, LIS3DE_FIFO_CTRL_REG, &wom->fifo_ctrl, 1);
+  }
+
+  if (ret == 0)
+  {
+    ret = lis3de_read_reg(ctx, LIS3DE_IG1_SOURCE, &dummy, 1);
   }
 
+  if (ret == 0)
+  {
+    wom->active = PROPERTY_DISABLE;
+  }
+
+  lis3de_unlock(ctx);
+
   return ret;
 }
 
 /**
-  * @brief  The time (1 LSB = 1/ODR) interval that starts after the first
-  *         click detection where the click-detection procedure is
-  *         disabled, in cases where the device is configured for
-  *         double-click detection.[get]
-  *
-  * @param  ctx      read / write interface definitions
-  * @param  val      change the values of tla in reg TIME_LATENCY
-  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  * @}
   *
   */
-int32_t lis3de_quiet_dur_get(const stmdev_ctx_t *ctx, uint8_t *val)
-{
-  lis3de_time_latency_t time_latency;
-  int32_t ret;
-
-  ret = lis3de_read_reg(ctx, LIS3DE_TIME_LATENCY,
-                        (uint8_t *)&time_latency, 1);
-  *val = (uint8_t)time_latency.tla;
 
-  return ret;
-}
+/**
+  * @defgroup  LIS3DE_Trace
+  * @brief     This section group the bus recorder and the replay
+  *            backend. A trace captured on the target through
+  *            lis3de_priv_t.trace is fed back by lis3de_replay_read /
+  *            lis3de_replay_write set as read_reg / write_reg of a host
+  *            context, so the processing chain (drain, conversions,
+  *            calibration, decimation, features) runs on field data
+  *            without the device. Reads answered by the shadow cache and
+  *            async reads are not on the trace: replay with the same
+  *            lis3de_priv_t options, without read_reg_async.
+  * @{
+  *
+  */
 
 /**
-  * @brief  The maximum interval of time (1 LSB = 1/ODR) that can elapse
-  *         after the end of the latency interval in which the click-detection
-  *         procedure can start, in cases where the device is configured
-  *         for double-click detection.[set]
+  * @brief  Start recording in buf, set the trace in lis3de_priv_t.
   *
-  * @param  ctx      read / write interface definitions
-  * @param  val      change the values of tw in reg TIME_WINDOW
-  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  * @param  trace    recorder object
+  * @param  buf      trace buffer
+  * @param  size     size of buf
+  * @retval          0 -> no Error, -1 -> invalid arguments
   *
   */
-int32_t lis3de_double_tap_timeout_set(const stmdev_ctx_t *ctx, uint8_t val)
+int32_t lis3de_trace_init(lis3de_trace_t *trace, uint8_t *buf,
+                          uint32_t size)
 {
-  lis3de_time_window_t time_window;
-  int32_t ret;
+  int32_t ret = 0;
 
-  ret = lis3de_read_reg(ctx, LIS3DE_TIME_WINDOW,
-                        (uint8_t *)&time_window, 1);
+  if (buf == NULL)
+  {
+    ret = -1;
+  }
 
-  if (ret == 0)
+  else
   {
-    time_window.tw = val;
-    ret = lis3de_write_reg(ctx, LIS3DE_TIME_WINDOW,
-                           (uint8_t *)&time_window, 1);
+    trace->buf = buf;
+    trace->size = size;
+    trace->len = 0U;
+    trace->dropped = 0U;
   }
 
   return ret;
 }
 
 /**
-  * @brief  The maximum interval of time (1 LSB = 1/ODR) that can elapse
-  *         after the end of the latency interval in which the
-  *         click-detection procedure can start, in cases where the device
-  *         is configured for double-click detection.[get]
+  * @brief  Replay backend initialization, set rp as the context handle.
   *
-  * @param  ctx      read / write interface definitions
-  * @param  val      change the values of tw in reg TIME_WINDOW
-  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  * @param  rp       replay object
+  * @param  buf      recorded trace
+  * @param  len      trace length, lis3de_trace_t.len
+  * @retval          0 -> no Error, -1 -> invalid arguments
   *
   */
-int32_t lis3de_double_tap_timeout_get(const stmdev_ctx_t *ctx, uint8_t *val)
+int32_t lis3de_replay_init(lis3de_replay_t *rp, const uint8_t *buf,
+                           uint32_t len)
 {
-  lis3de_time_window_t time_window;
-  int32_t ret;
+  int32_t ret = 0;
 
-  ret = lis3de_read_reg(ctx, LIS3DE_TIME_WINDOW,
-                        (uint8_t *)&time_window, 1);
-  *val = (uint8_t)time_window.tw;
+  if (buf == NULL)
+  {
+    ret = -1;
+  }
+
+  else
+  {
+    rp->buf = buf;
+    rp->len = len;
+    rp->pos = 0U;
+    rp->mismatch = 0U;
+  }
 
   return ret;
 }
 
 /**
-  * @}
+  * @brief  Restart the replay from the first record, e.g. to loop a
+  *         trace in a benchmark.
   *
-  */
-
-/**
-  * @defgroup  LIS3DE_Activity_inactivity
-  * @brief     This section group all the functions concerning activity
-  *            inactivity functionality
-  * @{
+  * @param  rp       replay object
   *
   */
+void lis3de_replay_rewind(lis3de_replay_t *rp)
+{
+  rp->pos = 0U;
+}
 
 /**
-  * @brief    Sleep-to-wake, return-to-sleep activation threshold in
-  *           low-power mode.[set]
-  *           1 LSb = 16mg@2g / 32mg@4g / 62mg@8g / 186mg@16g
+  * @brief  Decode the record at pos.
   *
-  * @param  ctx      read / write interface definitions
-  * @param  val      change the values of acth in reg ACT_THS
-  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  * @param  rp       replay object
+  * @param  pos      record offset, moved to the next record
+  * @param  flags    byte 0 of the record
+  * @param  len      transaction length
+  * @param  data     recorded bytes, 0 on error records
+  * @retval          0 -> record decoded, -1 -> end of trace
   *
   */
-int32_t lis3de_act_threshold_set(const stmdev_ctx_t *ctx, uint8_t val)
+static int32_t lis3de_replay_rec(const lis3de_replay_t *rp, uint32_t *pos,
+                                 uint8_t *flags, uint16_t *len,
+                                 uint16_t *data)
 {
-  lis3de_act_ths_t act_ths;
-  int32_t ret;
-
-  ret = lis3de_read_reg(ctx, LIS3DE_ACT_THS, (uint8_t *)&act_ths, 1);
+  uint32_t at = *pos;
+  int32_t ret = -1;
 
-  if (ret == 0)
+  if ((at + 2U) <= rp->len)
   {
-    act_ths.acth = val;
-    ret = lis3de_write_reg(ctx, LIS3DE_ACT_THS, (uint8_t *)&act_ths, 1);
-  }
+    *flags = rp->buf[at];
+    *len = rp->buf[at + 1U];
+    at += 2U;
 
-  return ret;
-}
+    if ((*len & 0x80U) != 0U)
+    {
+      if (at < rp->len)
+      {
+        *len = (uint16_t)(((*len & 0x7FU) << 8) | rp->buf[at]);
+        ret = 0;
+      }
 
-/**
-  * @brief  Sleep-to-wake, return-to-sleep activation threshold in low-power
-  *         mode.[get]
-  *         1 LSb = 16mg@2g / 32mg@4g / 62mg@8g / 186mg@16g
-  *
-  * @param  ctx      read / write interface definitions
-  * @param  val      change the values of acth in reg ACT_THS
-  * @retval          interface status (MANDATORY: return 0 -> no Error)
-  *
-  */
-int32_t lis3de_act_threshold_get(const stmdev_ctx_t *ctx, uint8_t *val)
-{
-  lis3de_act_ths_t act_ths;
-  int32_t ret;
+      at++;
+    }
 
-  ret = lis3de_read_reg(ctx, LIS3DE_ACT_THS, (uint8_t *)&act_ths, 1);
-  *val = (uint8_t)act_ths.acth;
+    else
+    {
+      ret = 0;
+    }
+
+    *data = ((*flags & LIS3DE_TRACE_ERROR) != 0U) ? 0U : *len;
+
+    if ((ret == 0) && ((at + *data) > rp->len))
+    {
+      ret = -1;
+    }
+
+    *pos = at + *data;
+  }
 
   return ret;
 }
 
 /**
-  * @brief  Sleep-to-wake, return-to-sleep.[set]
-  *         duration = (8*1[LSb]+1)/ODR
+  * @brief  stmdev_read_ptr of the replay, handle is a lis3de_replay_t.
+  *         Write records are skipped; the next read record must have the
+  *         register and length of the request, its bytes and status are
+  *         returned.
   *
-  * @param  ctx      read / write interface definitions
-  * @param  val      change the values of actd in reg ACT_DUR
-  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  * @param  handle   replay object
+  * @param  reg      register, sub-address flags ignored
+  * @param  data     bytes read
+  * @param  len      number of bytes
+  * @retval          recorded status, -1 on mismatch or end of trace
   *
   */
-int32_t lis3de_act_timeout_set(const stmdev_ctx_t *ctx, uint8_t val)
+int32_t lis3de_replay_read(void *handle, uint8_t reg, uint8_t *data,
+                           uint16_t len)
 {
-  lis3de_act_dur_t act_dur;
+  lis3de_replay_t *rp = (lis3de_replay_t *)handle;
+  uint32_t pos = rp->pos;
+  uint8_t flags = 0U;
+  uint16_t num = 0U;
+  uint16_t cnt = 0U;
+  uint16_t i;
   int32_t ret;
 
-  ret = lis3de_read_reg(ctx, LIS3DE_ACT_DUR, (uint8_t *)&act_dur, 1);
+  do
+  {
+    ret = lis3de_replay_rec(rp, &pos, &flags, &num, &cnt);
+  } while ((ret == 0) && ((flags & LIS3DE_TRACE_WRITE) != 0U));
+
+  if ((ret == 0) && (((flags & LIS3DE_ADDR_MASK) !=
+                      (reg & LIS3DE_ADDR_MASK)) || (num != len)))
+  {
+    ret = -1;
+  }
 
   if (ret == 0)
   {
-    act_dur.actd = val;
-    ret = lis3de_write_reg(ctx, LIS3DE_ACT_DUR, (uint8_t *)&act_dur, 1);
+    rp->pos = pos;
+
+    if ((flags & LIS3DE_TRACE_ERROR) != 0U)
+    {
+      ret = -1;
+    }
+
+    for (i = 0U; i < cnt; i++)
+    {
+      data[i] = rp->buf[(pos - cnt) + i];
+    }
+  }
+
+  else
+  {
+    /* pos not moved, the record is left for the next read */
+    rp->mismatch++;
   }
 
   return ret;
 }
 
 /**
-  * @brief  Sleep-to-wake, return-to-sleep.[get]
-  *         duration = (8*1[LSb]+1)/ODR
+  * @brief  stmdev_write_ptr of the replay, writes are accepted and
+  *         dropped (their records are skipped by lis3de_replay_read).
   *
-  * @param  ctx      read / write interface definitions
-  * @param  val      change the values of actd in reg ACT_DUR
-  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  * @param  handle   replay object
+  * @param  reg      register
+  * @param  data     bytes to write
+  * @param  len      number of bytes
+  * @retval          0
   *
   */
-int32_t lis3de_act_timeout_get(const stmdev_ctx_t *ctx, uint8_t *val)
+int32_t lis3de_replay_write(void *handle, uint8_t reg, const uint8_t *data,
+                            uint16_t len)
 {
-  lis3de_act_dur_t act_dur;
-  int32_t ret;
+  (void)handle;
+  (void)reg;
+  (void)data;
+  (void)len;
 
-  ret = lis3de_read_reg(ctx, LIS3DE_ACT_DUR, (uint8_t *)&act_dur, 1);
-  *val = (uint8_t)act_dur.actd;
-
-  return ret;
+  return 0;
 }
 
 /**
@@ -2493,6 +7299,8 @@ int32_t lis3de_spi_mode_set(const stmdev_ctx_t *ctx, lis3de_sim_t val)
   lis3de_ctrl_reg4_t ctrl_reg4;
   int32_t ret;
 
+  lis3de_lock(ctx);
+
   ret = lis3de_read_reg(ctx, LIS3DE_CTRL_REG4, (uint8_t *)&ctrl_reg4, 1);
 
   if (ret == 0)
@@ -2501,6 +7309,8 @@ int32_t lis3de_spi_mode_set(const stmdev_ctx_t *ctx, lis3de_sim_t val)
     ret = lis3de_write_reg(ctx, LIS3DE_CTRL_REG4, (uint8_t *)&ctrl_reg4, 1);
   }
 
+  lis3de_unlock(ctx);
+
   return ret;
 }
 
@@ -2537,6 +7347,68 @@ int32_t lis3de_spi_mode_get(const stmdev_ctx_t *ctx, lis3de_sim_t *val)
   return ret;
 }
 
+/**
+  * @brief  Bus transport.[set]
+  *         Stored in lis3de_priv_t.bus (priv_data is mandatory), from
+  *         then on the driver sets the SPI read and MS bits or the I2C
+  *         auto-increment bit, the platform read / write routines only
+  *         move bytes. With multi-byte access lis3de_sample_get reads
+  *         STATUS_REG and the outputs in one chip select assertion.
+  *         LIS3DE_BUS_SPI_3W writes CTRL_REG4 blind, as SDO cannot be
+  *         read back before SIM is set: call it first after power-up,
+  *         the other CTRL_REG4 fields are taken from a valid shadow
+  *         cache or left at reset value.
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      transport of the context
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lis3de_bus_set(const stmdev_ctx_t *ctx, lis3de_bus_t val)
+{
+  lis3de_priv_t *priv = (lis3de_priv_t *)ctx->priv_data;
+  lis3de_shadow_t *shadow = lis3de_shadow(ctx);
+  lis3de_ctrl_reg4_t ctrl_reg4;
+  int32_t ret = 0;
+
+  if (priv == NULL)
+  {
+    return -1;
+  }
+
+  lis3de_lock(ctx);
+
+  priv->bus = val;
+
+  if (val == LIS3DE_BUS_SPI_3W)
+  {
+    *(uint8_t *)&ctrl_reg4 = 0x00U;
+
+    if ((shadow != NULL) && (shadow->valid == PROPERTY_ENABLE))
+    {
+      *(uint8_t *)&ctrl_reg4 = shadow->reg[LIS3DE_CTRL_REG4 -
+                                           LIS3DE_TEMP_CFG_REG];
+    }
+
+    ctrl_reg4.sim = (uint8_t)LIS3DE_SPI_3_WIRE;
+    ret = lis3de_write_reg(ctx, LIS3DE_CTRL_REG4, (uint8_t *)&ctrl_reg4, 1);
+  }
+
+  else if (val == LIS3DE_BUS_SPI_4W)
+  {
+    ret = lis3de_spi_mode_set(ctx, LIS3DE_SPI_4_WIRE);
+  }
+
+  else
+  {
+    /* SIM is don't care on I2C */
+  }
+
+  lis3de_unlock(ctx);
+
+  return ret;
+}
+
 /**
   * @}
   *
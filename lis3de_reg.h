@@ -122,6 +122,9 @@ typedef struct
   stmdev_mdelay_ptr   mdelay;
   /** Customizable optional pointer **/
   void *handle;
+
+  /** private data **/
+  void *priv_data;
 } stmdev_ctx_t;
 
 /**
@@ -376,6 +379,7 @@ typedef struct
 #endif /* DRV_BYTE_ORDER */
 } lis3de_status_reg_t;
 
+#define LIS3DE_OUT_X_L               0x28U /* unused low byte, burst start */
 #define LIS3DE_OUT_X                 0x29U
 #define LIS3DE_OUT_Y                 0x2BU
 #define LIS3DE_OUT_Z                 0x2DU
@@ -698,6 +702,153 @@ typedef union
   uint8_t                 byte;
 } lis3de_reg_t;
 
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup LIS3DE_Private_data
+  * @brief    Optional driver data referenced by the priv_data field of
+  *           stmdev_ctx_t. Leaving priv_data to NULL keeps the legacy
+  *           single-register access on every transaction.
+  * @{
+  *
+  */
+
+typedef enum
+{
+  LIS3DE_MULTI_RW_OFF   = 0x00, /* one register per transaction */
+  LIS3DE_MULTI_RW_I2C   = 0x80, /* sub-address auto-increment bit (I2C) */
+  LIS3DE_MULTI_RW_SPI   = 0x40, /* MS bit (SPI) */
+} lis3de_multi_rw_t;
+
+/** Bus transport, see lis3de_bus_set **/
+typedef enum
+{
+  LIS3DE_BUS_RAW        = 0, /* addresses passed as is to the platform */
+  LIS3DE_BUS_I2C        = 1, /* 80h auto-increment on bursts */
+  LIS3DE_BUS_SPI_4W     = 2, /* 80h read bit, 40h MS bit on bursts */
+  LIS3DE_BUS_SPI_3W     = 3, /* as SPI_4W, SIM set in CTRL_REG4 */
+} lis3de_bus_t;
+
+/** Completion of a non-blocking transaction, status 0 -> no Error **/
+typedef void (*lis3de_done_ptr)(int32_t status, void *user);
+typedef int32_t (*lis3de_read_async_ptr)(void *handle, uint8_t reg,
+                                         uint8_t *data, uint16_t len,
+                                         lis3de_done_ptr done, void *user);
+/** Platform time base, any unit **/
+typedef uint32_t (*lis3de_tick_ptr)(void);
+/** Platform mutual exclusion, must be recursive (see lis3de_priv_t) **/
+typedef void (*lis3de_lock_ptr)(void *handle);
+
+/** register address without the sub-address flags **/
+#define LIS3DE_ADDR_MASK             0x3FU
+
+/** Writable configuration registers, TEMP_CFG_REG (1Fh) .. ACT_DUR (3Fh) **/
+#define LIS3DE_SHADOW_SIZE           33U
+typedef struct
+{
+  uint8_t reg[LIS3DE_SHADOW_SIZE];
+  uint8_t valid;
+  uint8_t staging;               /* inside lis3de_cfg_begin / commit */
+  uint64_t dirty;                /* staged registers, bit n -> 1Fh + n */
+} lis3de_shadow_t;
+
+#ifdef LIS3DE_BUS_STATS
+/** Bus counters of a register (build with LIS3DE_BUS_STATS defined),
+  * times in lis3de_priv_t.tick units **/
+typedef struct
+{
+  uint32_t reads;
+  uint32_t writes;
+  uint32_t bytes;
+  uint32_t errors;
+  uint32_t lat_min;
+  uint32_t lat_max;
+  uint32_t lat_sum;
+} lis3de_reg_stats_t;
+typedef struct
+{
+  lis3de_reg_stats_t reg[LIS3DE_ADDR_MASK + 1U];
+} lis3de_stats_t;
+#endif /* LIS3DE_BUS_STATS */
+
+/** Bus trace, see lis3de_trace_init. One record per transaction:
+  *   byte 0     bits 5..0 register, bit 6 write, bit 7 error
+  *   length     1 byte below 80h, else 2 bytes big endian with bit 15 set
+  *   data       length bytes, none on error **/
+#define LIS3DE_TRACE_WRITE           0x40U
+#define LIS3DE_TRACE_ERROR           0x80U
+typedef struct
+{
+  uint8_t *buf;
+  uint32_t size;
+  uint32_t len;                  /* bytes recorded */
+  uint32_t dropped;              /* transactions not recorded, buf full */
+} lis3de_trace_t;
+
+typedef enum
+{
+  LIS3DE_EVT_IA1         = 0,  /* interrupt generator 1, AOI mode */
+  LIS3DE_EVT_IA2         = 1,  /* interrupt generator 2, AOI mode */
+  LIS3DE_EVT_6D          = 2,  /* either generator in 6D mode */
+  LIS3DE_EVT_SINGLE_TAP  = 3,
+  LIS3DE_EVT_DOUBLE_TAP  = 4,
+  LIS3DE_EVT_DRDY        = 5,
+  LIS3DE_EVT_FIFO_WTM    = 6,
+  LIS3DE_EVT_FIFO_OVR    = 7,
+  LIS3DE_EVT_SLEEP       = 8,  /* activity / inactivity on INT2 */
+  LIS3DE_EVT_WAKE        = 9,
+  LIS3DE_EVT_NUM         = 10,
+} lis3de_evt_id_t;
+
+/** Pre-decoded event, fields not meaningful for an event are 0 **/
+typedef struct
+{
+  lis3de_evt_id_t id;
+  uint8_t src;                   /* raw source register */
+  uint8_t axes;                  /* tap: x, y, z bits; IA / 6D: xl .. zh bits */
+  uint8_t sign;                  /* tap: 1 -> negative */
+  uint8_t level;                 /* FIFO: unread samples */
+} lis3de_event_t;
+typedef void (*lis3de_evt_ptr)(const lis3de_event_t *evt, void *user);
+typedef struct
+{
+  lis3de_evt_ptr cb;
+  void *user;
+} lis3de_evt_slot_t;
+
+typedef struct
+{
+  lis3de_multi_rw_t  multi_rw;
+  /** optional: start a read and return, done is called on completion **/
+  lis3de_read_async_ptr  read_reg_async;
+  /** optional: setters write only and getters answer from RAM **/
+  lis3de_shadow_t  *shadow;
+  /** optional: timestamp source for sample records **/
+  lis3de_tick_ptr  tick;
+  /** optional: taken around read-modify-write and multi-transaction
+    * sequences only. Composite functions call the setters, so the
+    * lock must be recursive; if a sequence runs from an ISR (e.g.
+    * lis3de_stream_irq_handler) the hooks must not block there. **/
+  lis3de_lock_ptr  lock;
+  lis3de_lock_ptr  unlock;
+  /** optional: LIS3DE_EVT_NUM handlers, see lis3de_on_event; the
+    * table is read as is: zero it or call lis3de_events_init first **/
+  lis3de_evt_slot_t  *events;
+  /** optional: transport, the driver builds the sub-address flags
+    * (keep multi_rw != LIS3DE_MULTI_RW_OFF for bursts) **/
+  lis3de_bus_t  bus;
+  /** optional: bus transactions recorded for lis3de_replay_read **/
+  lis3de_trace_t  *trace;
+#ifdef LIS3DE_BUS_STATS
+  /** optional: bus counters, zero-initialized or cleared by
+    * lis3de_stats_reset **/
+  lis3de_stats_t  *stats;
+#endif /* LIS3DE_BUS_STATS */
+} lis3de_priv_t;
+
 /**
   * @}
   *
@@ -713,7 +864,8 @@ typedef union
  * The driver keeps offering a default implementation based on function
  * pointers to read/write routines for backward compatibility.
  * The __weak directive allows the final application to overwrite
- * them with a custom implementation.
+ * them with a custom implementation; the shadow cache of lis3de_priv_t
+ * is only handled by the default implementation.
  */
 
 int32_t lis3de_read_reg(const stmdev_ctx_t *ctx, uint8_t reg, uint8_t *data,
@@ -721,6 +873,15 @@ int32_t lis3de_read_reg(const stmdev_ctx_t *ctx, uint8_t reg, uint8_t *data,
 int32_t lis3de_write_reg(const stmdev_ctx_t *ctx, uint8_t reg,
                          uint8_t *data,
                          uint16_t len);
+int32_t lis3de_shadow_sync(const stmdev_ctx_t *ctx);
+int32_t lis3de_cfg_begin(const stmdev_ctx_t *ctx);
+int32_t lis3de_cfg_commit(const stmdev_ctx_t *ctx);
+int32_t lis3de_cfg_abort(const stmdev_ctx_t *ctx);
+#ifdef LIS3DE_BUS_STATS
+int32_t lis3de_stats_get(const stmdev_ctx_t *ctx, uint8_t reg,
+                         lis3de_reg_stats_t *val);
+int32_t lis3de_stats_reset(const stmdev_ctx_t *ctx);
+#endif /* LIS3DE_BUS_STATS */
 
 float_t lis3de_from_fs2_to_mg(int16_t lsb);
 float_t lis3de_from_fs4_to_mg(int16_t lsb);
@@ -811,6 +972,48 @@ typedef enum
 int32_t lis3de_full_scale_set(const stmdev_ctx_t *ctx, lis3de_fs_t val);
 int32_t lis3de_full_scale_get(const stmdev_ctx_t *ctx, lis3de_fs_t *val);
 
+void lis3de_from_fs_to_mg_block(lis3de_fs_t fs, const int16_t *in,
+                                float_t *out, size_t n);
+
+/** Integer sensitivities: micro-g per LSB and mg per LSB in Q16.16 **/
+#define LIS3DE_FS2_UG_PER_LSB        15600
+#define LIS3DE_FS4_UG_PER_LSB        31200
+#define LIS3DE_FS8_UG_PER_LSB        62500
+#define LIS3DE_FS16_UG_PER_LSB       187500
+#define LIS3DE_FS2_Q16_PER_LSB       1022362  /* 15.6 * 65536, rounded */
+#define LIS3DE_FS4_Q16_PER_LSB       2044723  /* 31.2 * 65536, rounded */
+#define LIS3DE_FS8_Q16_PER_LSB       4096000
+#define LIS3DE_FS16_Q16_PER_LSB      12288000
+int32_t lis3de_from_fs_to_ug(lis3de_fs_t fs, int16_t lsb);
+int32_t lis3de_from_fs_to_mg_q16(lis3de_fs_t fs, int16_t lsb);
+void lis3de_from_fs_to_ug_block(lis3de_fs_t fs, const int16_t *in,
+                                int32_t *out, size_t n);
+void lis3de_from_fs_to_mg_q16_block(lis3de_fs_t fs, const int16_t *in,
+                                    int32_t *out, size_t n);
+
+/** Per-axis offset, gain and optional misalignment matrix **/
+typedef struct
+{
+  float_t offset[3];             /* mg, subtracted before the matrix */
+  float_t m[9];                  /* row major, only m[0], m[4], m[8] if !full */
+  uint8_t full;                  /* use the off-diagonal terms */
+} lis3de_cal_t;
+typedef struct
+{
+  int32_t offset_ug[3];
+  int16_t m_q14[9];
+  uint8_t full;
+} lis3de_cal_q_t;
+void lis3de_cal_init(lis3de_cal_t *cal);
+void lis3de_cal_q_init(lis3de_cal_q_t *cal);
+void lis3de_from_fs_to_mg_cal_block(lis3de_fs_t fs, const lis3de_cal_t *cal,
+                                    const int16_t *in, float_t *out,
+                                    size_t num);
+void lis3de_from_fs_to_ug_cal_block(lis3de_fs_t fs,
+                                    const lis3de_cal_q_t *cal,
+                                    const int16_t *in, int32_t *out,
+                                    size_t num);
+
 int32_t lis3de_block_data_update_set(const stmdev_ctx_t *ctx, uint8_t val);
 int32_t lis3de_block_data_update_get(const stmdev_ctx_t *ctx, uint8_t *val);
 
@@ -823,6 +1026,15 @@ int32_t lis3de_xl_data_ovr_get(const stmdev_ctx_t *ctx, uint8_t *val);
 
 int32_t lis3de_acceleration_raw_get(const stmdev_ctx_t *ctx, int16_t *buff);
 
+typedef struct
+{
+  uint32_t timestamp;            /* tick at read time, 0 without tick */
+  int16_t xyz[3];
+  uint8_t zyxda;
+  uint8_t zyxor;
+} lis3de_sample_t;
+int32_t lis3de_sample_get(const stmdev_ctx_t *ctx, lis3de_sample_t *val);
+
 int32_t lis3de_device_id_get(const stmdev_ctx_t *ctx, uint8_t *buff);
 
 typedef enum
@@ -834,12 +1046,44 @@ typedef enum
 int32_t lis3de_self_test_set(const stmdev_ctx_t *ctx, lis3de_st_t val);
 int32_t lis3de_self_test_get(const stmdev_ctx_t *ctx, lis3de_st_t *val);
 
+/** Self-test limits on the output change, override for the part grade **/
+#ifndef LIS3DE_ST_MIN_MG
+#define LIS3DE_ST_MIN_MG             68
+#endif
+#ifndef LIS3DE_ST_MAX_MG
+#define LIS3DE_ST_MAX_MG             1440
+#endif
+/** Settling time after a configuration change, ms **/
+#ifndef LIS3DE_ST_SETTLE_MS
+#define LIS3DE_ST_SETTLE_MS          15U
+#endif
+/** Samples averaged per measurement, the nominal FIFO fill time at
+  * 400 Hz, then FIFO_SRC polled every ms up to LIS3DE_ST_FILL_MAX_MS
+  * (+50%, covers the ODR tolerance) **/
+#define LIS3DE_ST_SAMPLES            16U
+#define LIS3DE_ST_FILL_MS            (((LIS3DE_ST_SAMPLES * 1000U) + 399U) / 400U)
+#define LIS3DE_ST_FILL_MAX_MS        ((LIS3DE_ST_FILL_MS * 3U) / 2U)
+typedef struct
+{
+  int32_t nost_mg[3];            /* X, Y, Z average, self-test off */
+  int32_t st_mg[3];              /* X, Y, Z average, self-test on */
+  int32_t delta_mg[3];           /* self-test output change */
+  int32_t offset_mg[3];          /* zero-g offset estimate */
+  uint8_t pass;                  /* all changes within the limits */
+} lis3de_st_result_t;
+int32_t lis3de_self_test_run(const stmdev_ctx_t *ctx,
+                             lis3de_st_result_t *val);
+
 int32_t lis3de_boot_set(const stmdev_ctx_t *ctx, uint8_t val);
 int32_t lis3de_boot_get(const stmdev_ctx_t *ctx, uint8_t *val);
 
 int32_t lis3de_status_get(const stmdev_ctx_t *ctx,
                           lis3de_status_reg_t *val);
 
+#define LIS3DE_UCF_BURST_MAX         32U
+int32_t lis3de_ucf_load(const stmdev_ctx_t *ctx, const ucf_line_t *lines,
+                        size_t n);
+
 int32_t lis3de_int1_gen_conf_set(const stmdev_ctx_t *ctx,
                                  lis3de_ig1_cfg_t *val);
 int32_t lis3de_int1_gen_conf_get(const stmdev_ctx_t *ctx,
@@ -924,6 +1168,30 @@ int32_t lis3de_pin_int2_config_set(const stmdev_ctx_t *ctx,
 int32_t lis3de_pin_int2_config_get(const stmdev_ctx_t *ctx,
                                    lis3de_ctrl_reg6_t *val);
 
+#define LIS3DE_IRQ_IA1               0x01U
+#define LIS3DE_IRQ_IA2               0x02U
+#define LIS3DE_IRQ_CLICK             0x04U
+#define LIS3DE_IRQ_DRDY              0x08U
+#define LIS3DE_IRQ_FIFO_WTM          0x10U
+#define LIS3DE_IRQ_FIFO_OVR          0x20U
+typedef struct
+{
+  uint8_t active;                /* LIS3DE_IRQ_* causes found set */
+  uint8_t routed;                /* LIS3DE_IRQ_* causes whose source was read */
+  lis3de_status_reg_t    status_reg;
+  lis3de_fifo_src_reg_t  fifo_src_reg;
+  lis3de_ig1_source_t    ig1_source;
+  lis3de_ig2_source_t    ig2_source;
+  lis3de_click_src_t     click_src;
+} lis3de_irq_snapshot_t;
+int32_t lis3de_irq_sources_get(const stmdev_ctx_t *ctx,
+                               lis3de_irq_snapshot_t *val);
+void lis3de_events_init(lis3de_evt_slot_t *events);
+int32_t lis3de_on_event(const stmdev_ctx_t *ctx, lis3de_evt_id_t id,
+                        lis3de_evt_ptr cb, void *user);
+int32_t lis3de_irq_dispatch(const stmdev_ctx_t *ctx);
+int32_t lis3de_act_dispatch(const stmdev_ctx_t *ctx, uint8_t asserted);
+
 int32_t lis3de_fifo_set(const stmdev_ctx_t *ctx, uint8_t val);
 int32_t lis3de_fifo_get(const stmdev_ctx_t *ctx, uint8_t *val);
 
@@ -961,6 +1229,249 @@ int32_t lis3de_fifo_ovr_flag_get(const stmdev_ctx_t *ctx, uint8_t *val);
 
 int32_t lis3de_fifo_fth_flag_get(const stmdev_ctx_t *ctx, uint8_t *val);
 
+#define LIS3DE_FIFO_SIZE             32U
+int32_t lis3de_fifo_read_batch(const stmdev_ctx_t *ctx, int16_t *xyz,
+                               uint8_t max, uint8_t *count);
+
+typedef enum
+{
+  LIS3DE_FIFO_OUT_S16         = 0, /* int16_t X, Y, Z interleaved */
+  LIS3DE_FIFO_OUT_S8          = 1, /* int8_t X, Y, Z interleaved */
+  LIS3DE_FIFO_OUT_S16_PLANAR  = 2, /* int16_t X[], Y[], Z[] */
+  LIS3DE_FIFO_OUT_MG_PLANAR   = 3, /* float_t X[], Y[], Z[] in mg */
+} lis3de_fifo_fmt_t;
+typedef struct
+{
+  lis3de_fifo_fmt_t fmt;
+  void *axis[3];                 /* planar: X, Y, Z; interleaved: [0] */
+  uint16_t stride;               /* items between samples, 0 -> packed */
+  uint8_t *bus;                  /* 6 * max bytes, NULL only for packed S16 */
+  lis3de_fs_t fs;                /* mg conversion */
+} lis3de_fifo_out_t;
+int32_t lis3de_fifo_read_out(const stmdev_ctx_t *ctx,
+                             const lis3de_fifo_out_t *out, uint8_t max,
+                             uint8_t *count);
+
+typedef struct
+{
+  int16_t *xyz;                  /* caller buffer of 3 * size items */
+  uint8_t count;                 /* samples stored in xyz */
+  volatile uint8_t ready;        /* set by the ISR, cleared on release */
+  /* side-band, see lis3de_stream_aux_set */
+  uint8_t aux_valid;             /* aux_status and adc read with this block */
+  lis3de_status_reg_aux_t aux_status;
+  int16_t adc[3];                /* OUT_ADC1 .. OUT_ADC3, left justified */
+  /* gap marker, see lis3de_stream_period_set */
+  uint8_t overrun;               /* FIFO overrun before this block */
+  uint32_t gap;                  /* samples lost just before this block */
+} lis3de_stream_block_t;
+#define LIS3DE_GAP_UNKNOWN           0xFFFFFFFFU
+
+typedef struct
+{
+  const stmdev_ctx_t *ctx;
+  lis3de_stream_block_t block[2];
+  uint8_t size;                  /* block capacity in samples */
+  uint8_t fill;                  /* block filled by the ISR */
+  uint8_t next;                  /* block returned by the next poll */
+  volatile uint32_t stalls;      /* watermarks met with both blocks busy */
+  volatile uint8_t stall_pending; /* INT1 re-armed by the next release */
+  uint8_t aux_div;               /* aux read every aux_div drains, 0 off */
+  uint8_t aux_cnt;
+  volatile uint32_t aux_errors;  /* failed aux reads, block still published */
+  uint32_t period;               /* 1 / ODR in tick units, 0 unknown */
+  uint32_t last_tick;            /* tick of the last drain */
+  uint8_t leftover;              /* samples left in the FIFO by it */
+  volatile uint32_t lost;        /* samples lost to overruns */
+} lis3de_stream_t;
+int32_t lis3de_stream_init(lis3de_stream_t *stream, const stmdev_ctx_t *ctx,
+                           int16_t *buf0, int16_t *buf1, uint8_t size);
+int32_t lis3de_stream_start(lis3de_stream_t *stream, uint8_t wtm);
+int32_t lis3de_stream_stop(lis3de_stream_t *stream);
+void lis3de_stream_aux_set(lis3de_stream_t *stream, uint8_t div);
+void lis3de_stream_period_set(lis3de_stream_t *stream, uint32_t period);
+int32_t lis3de_stream_irq_handler(lis3de_stream_t *stream);
+lis3de_stream_block_t *lis3de_stream_poll(lis3de_stream_t *stream);
+int32_t lis3de_stream_release_block(lis3de_stream_t *stream,
+                                    lis3de_stream_block_t *blk);
+
+typedef struct
+{
+  const stmdev_ctx_t *ctx;
+  lis3de_done_ptr done;
+  void *user;
+  int16_t *xyz;
+  uint8_t *count;
+  uint8_t max;
+  int8_t raw[6];
+  lis3de_fifo_src_reg_t fifo_src_reg;
+} lis3de_async_t;
+int32_t lis3de_acceleration_raw_get_async(const stmdev_ctx_t *ctx,
+                                          lis3de_async_t *req,
+                                          int16_t *buff,
+                                          lis3de_done_ptr done, void *user);
+int32_t lis3de_fifo_status_get_async(const stmdev_ctx_t *ctx,
+                                     lis3de_async_t *req,
+                                     lis3de_fifo_src_reg_t *val,
+                                     lis3de_done_ptr done, void *user);
+int32_t lis3de_fifo_read_batch_async(const stmdev_ctx_t *ctx,
+                                     lis3de_async_t *req, int16_t *xyz,
+                                     uint8_t max, uint8_t *count,
+                                     lis3de_done_ptr done, void *user);
+
+typedef void (*lis3de_sched_cb_t)(uint8_t idx, const int16_t *xyz,
+                                  uint8_t count, void *user);
+typedef struct
+{
+  const stmdev_ctx_t *ctx;
+  int16_t *xyz;                  /* 3 * LIS3DE_FIFO_SIZE items */
+  uint32_t period;               /* 1 / ODR in tick units */
+  volatile uint32_t event_tick;  /* last watermark event */
+  volatile uint8_t pending;
+  uint8_t wtm;
+  uint32_t latency_last;         /* event to drain start, tick units */
+  uint32_t latency_max;
+  uint32_t drains;
+  uint32_t overruns;             /* drains that found the FIFO overrun */
+} lis3de_sched_dev_t;
+
+typedef struct
+{
+  lis3de_sched_dev_t *dev;
+  uint8_t num;
+  lis3de_tick_ptr tick;
+  lis3de_sched_cb_t cb;
+  void *user;
+} lis3de_sched_t;
+int32_t lis3de_sched_init(lis3de_sched_t *sched, lis3de_sched_dev_t *dev,
+                          uint8_t num, lis3de_tick_ptr tick,
+                          lis3de_sched_cb_t cb, void *user);
+int32_t lis3de_sched_dev_set(lis3de_sched_t *sched, uint8_t idx,
+                             const stmdev_ctx_t *ctx, int16_t *xyz,
+                             uint32_t period, uint8_t wtm);
+void lis3de_sched_notify(lis3de_sched_t *sched, uint8_t idx);
+int32_t lis3de_sched_run(lis3de_sched_t *sched);
+
+/** Store barrier between slot and index updates. Volatile accesses
+  * keep the order on single core targets; define it to a DMB (or the
+  * compiler equivalent) when producer and consumer run on different
+  * cores. **/
+#ifndef LIS3DE_RING_BARRIER
+#define LIS3DE_RING_BARRIER()
+#endif
+
+typedef struct
+{
+  volatile lis3de_sample_t *buf;
+  uint32_t mask;                 /* slots - 1 */
+  volatile uint32_t head;        /* written by the producer only */
+  volatile uint32_t tail;        /* written by the consumer only */
+} lis3de_ring_t;
+int32_t lis3de_ring_init(lis3de_ring_t *ring, lis3de_sample_t *buf,
+                         uint32_t size);
+int32_t lis3de_ring_put(lis3de_ring_t *ring, const lis3de_sample_t *sample);
+int32_t lis3de_ring_get(lis3de_ring_t *ring, lis3de_sample_t *sample);
+uint32_t lis3de_ring_count(const lis3de_ring_t *ring);
+
+#define LIS3DE_DECIM_TAPS_MAX        32U
+typedef struct
+{
+  const int16_t *coef;           /* Q15, NULL -> boxcar */
+  uint8_t taps;
+  uint8_t factor;
+  uint8_t phase;                 /* inputs since the last output */
+  uint8_t pos;                   /* next history slot */
+  int16_t hist[3][LIS3DE_DECIM_TAPS_MAX];
+} lis3de_decim_t;
+int32_t lis3de_decim_init(lis3de_decim_t *dec, const int16_t *coef,
+                          uint8_t taps, uint8_t factor);
+uint8_t lis3de_decim_run(lis3de_decim_t *dec, int16_t *xyz, uint8_t count);
+
+/** Features of one axis over a window, LSB unless noted **/
+typedef struct
+{
+  int16_t mean;
+  uint16_t rms;
+  uint16_t p2p;                  /* peak-to-peak */
+  uint16_t crest;                /* max |x| / rms, Q8, saturated */
+  uint16_t zc;                   /* crossings of the previous window mean */
+} lis3de_feat_axis_t;
+typedef struct
+{
+  lis3de_feat_axis_t axis[3];
+  uint16_t count;                /* samples in the window */
+} lis3de_feat_t;
+typedef struct
+{
+  uint16_t window;               /* samples per window */
+  uint16_t n;                    /* samples in the current window */
+  int32_t sum[3];
+  uint64_t sumsq[3];
+  int16_t min[3];
+  int16_t max[3];
+  uint16_t zc[3];
+  int16_t bias[3];               /* zero crossing reference */
+  int8_t sign[3];                /* last non-zero sign about bias */
+} lis3de_feat_engine_t;
+int32_t lis3de_feat_init(lis3de_feat_engine_t *fe, uint16_t window);
+uint8_t lis3de_feat_run(lis3de_feat_engine_t *fe, const int16_t *xyz,
+                        uint8_t count, lis3de_feat_t *out, uint8_t max);
+
+#define LIS3DE_PACK_HDR_SIZE         10U
+typedef enum
+{
+  LIS3DE_PACK_RAW     = 0,       /* 3 bytes per sample */
+  LIS3DE_PACK_DELTA   = 1,       /* zigzag 4-bit varint deltas */
+} lis3de_pack_codec_t;
+typedef struct
+{
+  lis3de_odr_t odr;
+  lis3de_fs_t fs;
+  lis3de_pack_codec_t codec;
+  uint8_t count;                 /* samples in the block */
+  uint16_t seq;
+  uint32_t timestamp;
+  uint16_t len;                  /* payload bytes */
+} lis3de_pack_hdr_t;
+typedef struct
+{
+  lis3de_pack_hdr_t hdr;
+  const uint8_t *payload;        /* points inside the packed block */
+  uint16_t pos;                  /* raw: bytes, delta: 4-bit groups */
+  uint8_t idx;
+  int16_t prev[3];
+} lis3de_pack_view_t;
+int32_t lis3de_pack_encode(lis3de_pack_hdr_t *hdr, const int16_t *xyz,
+                           uint8_t *buf, uint16_t size);
+int32_t lis3de_pack_view(lis3de_pack_view_t *view, const uint8_t *buf,
+                         uint16_t len);
+int32_t lis3de_pack_next(lis3de_pack_view_t *view, int16_t *xyz);
+
+typedef struct
+{
+  float_t nominal;               /* 1 / ODR, tick units */
+  float_t lambda;                /* forgetting factor */
+  float_t period;                /* estimated sample period */
+  float_t w;                     /* fit weight */
+  float_t mx;                    /* weighted means, relative to the origin */
+  float_t my;
+  float_t sxx;
+  float_t sxy;
+  uint32_t t_org;                /* origin: last event tick ... */
+  uint32_t k_org;                /* ... and its sample index */
+  uint32_t index;                /* samples drained so far */
+} lis3de_ts_t;
+typedef struct
+{
+  uint32_t t0;                   /* tick of the first sample */
+  float_t period;
+  uint8_t count;
+} lis3de_ts_batch_t;
+int32_t lis3de_ts_init(lis3de_ts_t *ts, float_t nominal, float_t lambda);
+void lis3de_ts_batch(lis3de_ts_t *ts, uint32_t t_irq, uint8_t level,
+                     uint8_t count, lis3de_ts_batch_t *batch);
+uint32_t lis3de_ts_sample(const lis3de_ts_batch_t *batch, uint8_t idx);
+
 int32_t lis3de_tap_conf_set(const stmdev_ctx_t *ctx,
                             lis3de_click_cfg_t *val);
 int32_t lis3de_tap_conf_get(const stmdev_ctx_t *ctx,
@@ -998,6 +1509,63 @@ int32_t lis3de_act_threshold_get(const stmdev_ctx_t *ctx, uint8_t *val);
 int32_t lis3de_act_timeout_set(const stmdev_ctx_t *ctx, uint8_t val);
 int32_t lis3de_act_timeout_get(const stmdev_ctx_t *ctx, uint8_t *val);
 
+typedef struct
+{
+  lis3de_odr_t odr;
+  lis3de_op_md_t op_md;
+  lis3de_fm_t fifo_md;
+  uint8_t wtm;
+  uint8_t act_dur;               /* ACT_DUR for this ODR */
+  uint32_t dwell;                /* minimum time at this level when idle */
+} lis3de_gov_level_t;
+typedef struct
+{
+  const stmdev_ctx_t *ctx;
+  const lis3de_gov_level_t *policy;
+  uint8_t num;
+  lis3de_tick_ptr tick;
+  uint8_t level;                 /* current policy index */
+  volatile uint8_t idle;
+  uint32_t since;                /* tick of the last level change */
+  uint32_t transitions;
+} lis3de_gov_t;
+int32_t lis3de_gov_init(lis3de_gov_t *gov, const stmdev_ctx_t *ctx,
+                        const lis3de_gov_level_t *policy, uint8_t num,
+                        lis3de_tick_ptr tick);
+int32_t lis3de_gov_activity(lis3de_gov_t *gov);
+void lis3de_gov_inactivity(lis3de_gov_t *gov);
+int32_t lis3de_gov_update(lis3de_gov_t *gov);
+
+/** Profile saved by lis3de_wom_enable, restored by lis3de_wom_disable **/
+typedef struct
+{
+  uint8_t ctrl[5];               /* CTRL_REG1 .. CTRL_REG5 */
+  uint8_t fifo_ctrl;             /* FIFO_CTRL_REG */
+  uint8_t ig1_cfg;               /* INT1_CFG */
+  uint8_t ig1_ths[2];            /* INT1_THS, INT1_DURATION */
+  uint8_t active;                /* zero before the first enable */
+} lis3de_wom_t;
+int32_t lis3de_wom_enable(const stmdev_ctx_t *ctx, lis3de_wom_t *wom,
+                          uint16_t threshold_mg, uint16_t duration_ms);
+int32_t lis3de_wom_disable(const stmdev_ctx_t *ctx, lis3de_wom_t *wom);
+
+typedef struct
+{
+  const uint8_t *buf;
+  uint32_t len;
+  uint32_t pos;                  /* next record */
+  uint32_t mismatch;             /* reads not matching the next record */
+} lis3de_replay_t;
+int32_t lis3de_trace_init(lis3de_trace_t *trace, uint8_t *buf,
+                          uint32_t size);
+int32_t lis3de_replay_init(lis3de_replay_t *rp, const uint8_t *buf,
+                           uint32_t len);
+void lis3de_replay_rewind(lis3de_replay_t *rp);
+int32_t lis3de_replay_read(void *handle, uint8_t reg, uint8_t *data,
+                           uint16_t len);
+int32_t lis3de_replay_write(void *handle, uint8_t reg, const uint8_t *data,
+                            uint16_t len);
+
 typedef enum
 {
   LIS3DE_SPI_4_WIRE = 0,
@@ -1005,6 +1573,7 @@ typedef enum
 } lis3de_sim_t;
 int32_t lis3de_spi_mode_set(const stmdev_ctx_t *ctx, lis3de_sim_t val);
 int32_t lis3de_spi_mode_get(const stmdev_ctx_t *ctx, lis3de_sim_t *val);
+int32_t lis3de_bus_set(const stmdev_ctx_t *ctx, lis3de_bus_t val);
 
 /**
   * @}
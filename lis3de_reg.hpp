@@ -0,0 +1,317 @@
+/**
+  ******************************************************************************
+  * @file    lis3de_reg.hpp
+  * @author  Sensors Software Solution Team
+  * @brief   Header-only C++17 wrapper of the lis3de_reg.c driver with the
+  *          bus and the configuration resolved at compile time.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2021 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under BSD 3-Clause license,
+  * the "License"; You may not use this file except in compliance with the
+  * License. You may obtain a copy of the License at:
+  *                        opensource.org/licenses/BSD-3-Clause
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef LIS3DE_REGS_HPP
+#define LIS3DE_REGS_HPP
+
+/* Includes ------------------------------------------------------------------*/
+#include "lis3de_reg.h"
+
+/** @addtogroup LIS3DE
+  * @{
+  *
+  */
+
+/** @defgroup LIS3DE_Cpp_wrapper
+  * @brief    lis3de::Device<Bus, Config> calls the bus policy directly, so
+  *           the transactions can be inlined: no function pointer, no weak
+  *           symbol, no virtual call.
+  *
+  *           Bus is a static policy:
+  *
+  *             struct MyBus
+  *             {
+  *               static constexpr uint8_t multi_rw = LIS3DE_MULTI_RW_I2C;
+  *               static int32_t read(uint8_t reg, uint8_t *data,
+  *                                   uint16_t len);
+  *               static int32_t write(uint8_t reg, const uint8_t *data,
+  *                                    uint16_t len);
+  *             };
+  *
+  *           Config is a lis3de::Config<...> instance (or any type with
+  *           the same constexpr members) and gives the init register
+  *           sequence and the sensitivity at compile time.
+  * @{
+  *
+  */
+
+namespace lis3de
+{
+
+/**
+  * @brief  Compile-time device configuration. int1 / int2 are the
+  *         CTRL_REG3 / CTRL_REG6 routing bytes.
+  *
+  */
+template <lis3de_odr_t Odr, lis3de_fs_t Fs,
+          lis3de_op_md_t Mode = LIS3DE_NM,
+          lis3de_fm_t Fifo = LIS3DE_BYPASS_MODE, uint8_t Wtm = 0U,
+          uint8_t Int1 = 0U, uint8_t Int2 = 0U, bool Bdu = true,
+          bool Spi3w = false>
+struct Config
+{
+  static_assert(Wtm < LIS3DE_FIFO_SIZE, "watermark out of range");
+
+  static constexpr lis3de_odr_t odr = Odr;
+  static constexpr lis3de_fs_t fs = Fs;
+  static constexpr lis3de_fm_t fifo = Fifo;
+
+  /* CTRL_REG1 .. CTRL_REG6 */
+  static constexpr uint8_t ctrl[6] =
+  {
+    static_cast<uint8_t>((static_cast<uint8_t>(Odr) << 4) |
+                         ((Mode == LIS3DE_LP) ? 0x08U : 0x00U) | 0x07U),
+    0x00U,
+    Int1,
+    static_cast<uint8_t>((Bdu ? 0x80U : 0x00U) |
+                         (static_cast<uint8_t>(Fs) << 4) |
+                         (Spi3w ? 0x01U : 0x00U)),
+    static_cast<uint8_t>((Fifo != LIS3DE_BYPASS_MODE) ? 0x40U : 0x00U),
+    Int2,
+  };
+
+  /* FIFO_CTRL_REG */
+  static constexpr uint8_t fifo_ctrl =
+    static_cast<uint8_t>((static_cast<uint8_t>(Fifo) << 6) | Wtm);
+};
+
+template <typename Bus, typename Cfg>
+class Device
+{
+public:
+  /** mg/LSB of Cfg::fs **/
+  static constexpr float_t sensitivity =
+    (Cfg::fs == LIS3DE_16g) ? 187.5f :
+    (Cfg::fs == LIS3DE_8g) ? 62.5f :
+    (Cfg::fs == LIS3DE_4g) ? 31.2f : 15.6f;
+
+  /** micro-g/LSB of Cfg::fs **/
+  static constexpr int32_t sensitivity_ug =
+    (Cfg::fs == LIS3DE_16g) ? LIS3DE_FS16_UG_PER_LSB :
+    (Cfg::fs == LIS3DE_8g) ? LIS3DE_FS8_UG_PER_LSB :
+    (Cfg::fs == LIS3DE_4g) ? LIS3DE_FS4_UG_PER_LSB : LIS3DE_FS2_UG_PER_LSB;
+
+  static constexpr float_t to_mg(int16_t lsb)
+  {
+    return static_cast<float_t>(lsb) * sensitivity;
+  }
+
+  static constexpr int32_t to_ug(int16_t lsb)
+  {
+    return static_cast<int32_t>(lsb) * sensitivity_ug;
+  }
+
+  /**
+    * @brief  Write the Cfg register sequence: FIFO stopped, CTRL_REG1 ..
+    *         CTRL_REG6 (one burst with multi-byte access), FIFO_CTRL_REG.
+    *
+    * @retval          interface status (MANDATORY: return 0 -> no Error)
+    *
+    */
+  static int32_t init()
+  {
+    const uint8_t bypass = 0x00U;
+    int32_t ret;
+
+    ret = Bus::write(LIS3DE_FIFO_CTRL_REG, &bypass, 1);
+
+    if (ret == 0)
+    {
+      ret = write_regs(LIS3DE_CTRL_REG1, Cfg::ctrl, 6);
+    }
+
+    if ((ret == 0) && (Cfg::fifo != LIS3DE_BYPASS_MODE))
+    {
+      ret = Bus::write(LIS3DE_FIFO_CTRL_REG, &Cfg::fifo_ctrl, 1);
+    }
+
+    return ret;
+  }
+
+  static int32_t device_id_get(uint8_t &id)
+  {
+    return Bus::read(LIS3DE_WHO_AM_I, &id, 1);
+  }
+
+  static int32_t status_get(lis3de_status_reg_t &val)
+  {
+    return Bus::read(LIS3DE_STATUS_REG, reinterpret_cast<uint8_t *>(&val),
+                     1);
+  }
+
+  /**
+    * @brief  Linear acceleration output register (X, Y, Z).[get]
+    *
+    * @param  xyz      raw samples
+    * @retval          interface status (MANDATORY: return 0 -> no Error)
+    *
+    */
+  static int32_t acceleration_raw_get(int16_t (&xyz)[3])
+  {
+    int32_t ret;
+
+    if constexpr (Bus::multi_rw != 0U)
+    {
+      int8_t raw[6];
+
+      ret = Bus::read(static_cast<uint8_t>(LIS3DE_OUT_X_L | Bus::multi_rw),
+                      reinterpret_cast<uint8_t *>(raw), 6);
+      xyz[0] = raw[1];
+      xyz[1] = raw[3];
+      xyz[2] = raw[5];
+    }
+
+    else
+    {
+      int8_t raw;
+
+      ret = Bus::read(LIS3DE_OUT_X, reinterpret_cast<uint8_t *>(&raw), 1);
+      xyz[0] = raw;
+
+      if (ret == 0)
+      {
+        ret = Bus::read(LIS3DE_OUT_Y, reinterpret_cast<uint8_t *>(&raw), 1);
+        xyz[1] = raw;
+      }
+
+      if (ret == 0)
+      {
+        ret = Bus::read(LIS3DE_OUT_Z, reinterpret_cast<uint8_t *>(&raw), 1);
+        xyz[2] = raw;
+      }
+    }
+
+    return ret;
+  }
+
+  /**
+    * @brief  Drain the FIFO, one FIFO_SRC_REG read then one burst.
+    *         Samples are stored interleaved (X, Y, Z) in xyz.
+    *
+    * @param  xyz      buffer of 3 * max items
+    * @param  max      maximum number of samples to read
+    * @param  count    number of samples read
+    * @retval          interface status (MANDATORY: return 0 -> no Error)
+    *
+    */
+  static int32_t fifo_read_batch(int16_t *xyz, uint8_t max, uint8_t &count)
+  {
+    static_assert(Bus::multi_rw != 0U, "FIFO burst needs multi_rw");
+    uint8_t src;
+    uint8_t num = 0U;
+    int32_t ret;
+
+    ret = Bus::read(LIS3DE_FIFO_SRC_REG, &src, 1);
+
+    if (ret == 0)
+    {
+      /* overrun means 32 unread samples */
+      num = ((src & 0x40U) != 0U) ? static_cast<uint8_t>(LIS3DE_FIFO_SIZE) :
+            static_cast<uint8_t>(src & 0x1FU);
+      num = (num > max) ? max : num;
+    }
+
+    if ((ret == 0) && (num > 0U))
+    {
+      const int8_t *raw = reinterpret_cast<const int8_t *>(xyz);
+
+      ret = Bus::read(static_cast<uint8_t>(LIS3DE_OUT_X_L | Bus::multi_rw),
+                      reinterpret_cast<uint8_t *>(xyz),
+                      static_cast<uint16_t>(num * 6U));
+
+      /* each item is written after the byte it overlaps has been read */
+      for (uint16_t i = 0U; i < (num * 3U); i++)
+      {
+        xyz[i] = raw[(i * 2U) + 1U];
+      }
+    }
+
+    count = num;
+
+    return ret;
+  }
+
+  /**
+    * @brief  Context for the C API, for the functions not wrapped here.
+    *
+    */
+  static stmdev_ctx_t ctx(lis3de_priv_t *priv = nullptr)
+  {
+    stmdev_ctx_t c = {};
+
+    c.write_reg = &c_write;
+    c.read_reg = &c_read;
+    c.priv_data = priv;
+
+    return c;
+  }
+
+private:
+  static int32_t write_regs(uint8_t reg, const uint8_t *data, uint8_t len)
+  {
+    int32_t ret = 0;
+
+    if constexpr (Bus::multi_rw != 0U)
+    {
+      ret = Bus::write(static_cast<uint8_t>(reg | Bus::multi_rw), data, len);
+    }
+
+    else
+    {
+      for (uint8_t i = 0U; (i < len) && (ret == 0); i++)
+      {
+        ret = Bus::write(static_cast<uint8_t>(reg + i), &data[i], 1);
+      }
+    }
+
+    return ret;
+  }
+
+  static int32_t c_write(void *handle, uint8_t reg, const uint8_t *data,
+                         uint16_t len)
+  {
+    (void)handle;
+    return Bus::write(reg, data, len);
+  }
+
+  static int32_t c_read(void *handle, uint8_t reg, uint8_t *data,
+                        uint16_t len)
+  {
+    (void)handle;
+    return Bus::read(reg, data, len);
+  }
+};
+
+} /* namespace lis3de */
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @}
+  *
+  */
+
+#endif /* LIS3DE_REGS_HPP */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/